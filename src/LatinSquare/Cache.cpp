@@ -0,0 +1,186 @@
+#include "Cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Constants.hpp"
+
+namespace LatinSquare {
+    Cache::Cache(const std::string& filename) noexcept : file_(-1), map_(nullptr), mapSize_(0) {
+        if (filename.empty()) {
+            return;
+        }
+
+        const auto file = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+        if (file < 0) {
+            return;
+        }
+
+        const auto tableEnd = CACHE_HEADER_SIZE + CACHE_SLOTS * sizeof(Slot);
+        std::array<char, CACHE_HEADER_SIZE> header {};
+        struct stat status;
+        ::flock(file, LOCK_EX);
+        auto valid = ::fstat(file, &status) == 0;
+
+        if (valid && status.st_size == 0) {
+            std::copy(CACHE_MAGIC.begin(), CACHE_MAGIC.end(), header.begin());
+            valid = ::ftruncate(file, tableEnd) == 0
+                    && ::pwrite(file, header.data(), header.size(), 0) == static_cast<ssize_t>(header.size());
+        } else if (valid) {
+            valid = static_cast<size_t>(status.st_size) >= tableEnd
+                    && ::pread(file, header.data(), header.size(), 0) == static_cast<ssize_t>(header.size())
+                    && std::string_view(header.data(), CACHE_MAGIC.size()) == CACHE_MAGIC;
+        }
+
+        ::flock(file, LOCK_UN);
+
+        if (!valid) {
+            ::close(file);
+            return;
+        }
+
+        file_ = file;
+    }
+
+    Cache::~Cache() noexcept {
+        unmap();
+
+        if (file_ >= 0) {
+            ::close(file_);
+        }
+    }
+
+    bool Cache::find(const std::string_view key, std::string& value) noexcept {
+        if (file_ < 0) {
+            return false;
+        }
+
+        auto found = false;
+        ::flock(file_, LOCK_SH);
+
+        if (map()) {
+            const auto slots = reinterpret_cast<const Slot*>(map_ + CACHE_HEADER_SIZE);
+            const auto keyHash = hash(key);
+
+            for (size_t probe = 0, index = keyHash % CACHE_SLOTS; probe < CACHE_SLOTS && slots[index].hash;
+                 ++probe, index = (index + 1) % CACHE_SLOTS) {
+                const auto& slot = slots[index];
+
+                if (slot.hash == keyHash && slot.offset + slot.keyLength + slot.valueLength <= mapSize_
+                    && std::string_view(map_ + slot.offset, slot.keyLength) == key) {
+                    value.assign(map_ + slot.offset + slot.keyLength, slot.valueLength);
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        ::flock(file_, LOCK_UN);
+        return found;
+    }
+
+    void Cache::insert(const std::string_view key, const std::string_view value) noexcept {
+        if (file_ < 0) {
+            return;
+        }
+
+        struct stat status;
+        ::flock(file_, LOCK_EX);
+
+        if (::fstat(file_, &status) == 0) {
+            const auto keyHash = hash(key);
+            Slot slot;
+
+            // Records are appended before their slot is published, so a reader never sees a slot without its data.
+            for (size_t probe = 0, index = keyHash % CACHE_SLOTS; probe < CACHE_SLOTS;
+                 ++probe, index = (index + 1) % CACHE_SLOTS) {
+                const auto position = CACHE_HEADER_SIZE + index * sizeof(Slot);
+
+                if (::pread(file_, &slot, sizeof(slot), position) != sizeof(slot) || slot.hash == keyHash) {
+                    break;
+                }
+
+                if (!slot.hash) {
+                    std::string record(key);
+                    record.append(value);
+                    slot = {keyHash, static_cast<uint64_t>(status.st_size), static_cast<uint32_t>(key.size()),
+                        static_cast<uint32_t>(value.size())};
+
+                    if (::pwrite(file_, record.data(), record.size(), status.st_size)
+                        == static_cast<ssize_t>(record.size())) {
+                        static_cast<void>(::pwrite(file_, &slot, sizeof(slot), position));
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        ::flock(file_, LOCK_UN);
+    }
+
+    std::string Cache::filename() noexcept {
+        if (const auto filename = std::getenv(CACHE_VARIABLE.data())) {
+            return filename;
+        }
+
+        if (const auto home = std::getenv("HOME")) {
+            std::string filename = home;
+            filename.push_back('/');
+            filename.append(CACHE_FILENAME);
+            return filename;
+        }
+
+        return {};
+    }
+
+    uint64_t Cache::hash(const std::string_view key) noexcept {
+        uint64_t result = 0xCBF29CE484222325;
+
+        for (const auto character : key) {
+            result = (result ^ static_cast<uint8_t>(character)) * 0x100000001B3;
+        }
+
+        // Zero marks an empty slot.
+        return result ? result : 1;
+    }
+
+    bool Cache::map() noexcept {
+        struct stat status;
+
+        if (::fstat(file_, &status) != 0) {
+            return false;
+        }
+
+        if (map_ && mapSize_ == static_cast<size_t>(status.st_size)) {
+            return true;
+        }
+
+        unmap();
+        const auto map = ::mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, file_, 0);
+
+        if (map == MAP_FAILED) {
+            return false;
+        }
+
+        map_ = static_cast<const char*>(map);
+        mapSize_ = status.st_size;
+        return true;
+    }
+
+    void Cache::unmap() noexcept {
+        if (map_) {
+            ::munmap(const_cast<char*>(map_), mapSize_);
+            map_ = nullptr;
+            mapSize_ = 0;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace LatinSquare {
+    class Cache {
+        public:
+            explicit Cache(const std::string& filename) noexcept;
+            ~Cache() noexcept;
+
+            Cache(const Cache&) = delete;
+            Cache& operator=(const Cache&) = delete;
+
+            [[nodiscard]] inline constexpr bool isOpen() const noexcept {
+                return file_ >= 0;
+            }
+
+            [[nodiscard]] bool find(const std::string_view key, std::string& value) noexcept;
+            void insert(const std::string_view key, const std::string_view value) noexcept;
+
+            [[nodiscard]] static std::string filename() noexcept;
+
+        private:
+            struct Slot {
+                uint64_t hash;
+                uint64_t offset;
+                uint32_t keyLength;
+                uint32_t valueLength;
+            };
+
+            [[nodiscard]] static uint64_t hash(const std::string_view key) noexcept;
+            [[nodiscard]] bool map() noexcept;
+            void unmap() noexcept;
+
+            int file_;
+            const char* map_;
+            size_t mapSize_;
+    };
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 
@@ -22,6 +23,16 @@ namespace LatinSquare {
 
     static constexpr uint_fast32_t MAX_ITERATIONS = 1000000;
     static constexpr uint_fast32_t SYMMETRIC_MAX_ITERATIONS = 2000000;
+    static constexpr uint_fast16_t SHARD_DEPTH = 4;
+    static constexpr size_t MAX_NOGOODS = 4096;
+    static constexpr size_t MAX_NOGOOD_LENGTH = 32;
+    static constexpr uint_fast8_t MAX_RECTANGLE_SIZE = 16;
+    static constexpr uint_fast8_t SYMBOL_REGIONS_MIN_SIZE = 11;
+    static constexpr uint_fast16_t MAX_CANONICAL_LEAVES = 16;
+    static constexpr size_t WRITER_BUFFER_SIZE = 1 << 20;
+    static constexpr size_t PARSER_BUFFER_SIZE = 1 << 16;
+    static constexpr size_t CACHE_HEADER_SIZE = 16;
+    static constexpr size_t CACHE_SLOTS = 4096;
 
     static constexpr std::string_view TYPE_NORMAL = "N";
     static constexpr std::string_view TYPE_REDUCED = "R";
@@ -42,7 +53,24 @@ namespace LatinSquare {
     static constexpr std::string_view SYMMETRIC_LATIN_SQUARES_TEMPLATE_FILE = "-sltf";
     static constexpr std::string_view SYMMETRIC_LATIN_SQUARES_TEMPLATE_COUNT = "-sltc";
 
+    static constexpr std::string_view SHARD = "--shard";
+    static constexpr std::string_view THREADS = "--threads";
+    static constexpr std::string_view SQUARES = "--squares";
+    static constexpr std::string_view MERGE = "-merge";
+    static constexpr std::string_view STANDARD_INPUT = "-";
+    static constexpr std::string_view SERVE = "--serve";
+    static constexpr std::string_view SERVE_END = "END\n";
+    static constexpr std::string_view NO_CACHE = "--no-cache";
+    static constexpr std::string_view PROPAGATION = "--gac";
+    static constexpr std::string_view BACKJUMPING = "--cbj";
+    static constexpr std::string_view MAXIMUM_COUNT = "--count";
+    static constexpr std::string_view DISTINCT = "--distinct";
+    static constexpr std::string_view CACHE_VARIABLE = "LATIN_SQUARE_CACHE";
+    static constexpr std::string_view CACHE_FILENAME = ".latinsquare_cache";
+    static constexpr std::string_view CACHE_MAGIC = "LSGCACH1";
+
     static constexpr std::string_view LATIN_SQUARES = "Number of Latin squares: ";
+    static constexpr std::string_view NOT_COMPLETABLE = "Template cannot be completed to a Latin square\n";
     static constexpr std::string_view USAGE =
         "USAGE:\n"
         "Generate random Latin square:\n"
@@ -71,8 +99,18 @@ namespace LatinSquare {
         "-sltc <triangular_input>\n\n"
         "Find random transversal in Latin square:\n"
         "-tr <full_input>\n"
+        "Find many random transversals in Latin square:\n"
+        "-trb <full_input> <count>\n"
         "Count number of transversals in Latin square:\n"
         "-tc <full_input>\n"
+        "Save all transversals in Latin square to file:\n"
+        "-te <full_input> <output>\n"
+        "Find longest partial transversal in Latin square:\n"
+        "-tp <full_input>\n"
+        "Find orthogonal mate of Latin square:\n"
+        "-om <full_input>\n"
+        "Find maximum number of disjoint transversals in Latin square:\n"
+        "-td <full_input>\n"
         "Find minimum and maximum number of transversals in Latin squares:\n"
         "-tm <size> <type>\n"
         "Find minimum and maximum number of transversals in Latin squares for template:\n"
@@ -85,14 +123,18 @@ namespace LatinSquare {
         "-stm <size> <type>\n"
         "Find minimum and maximum number of transversals in symmetric Latin squares for template:\n"
         "-stt <triangular_input>\n\n"
-        // "Find random transversal in symmetric Latin square using lower-triangular grid:\n"
-        // "-sttr <triangular_input>\n"
+        "Find random transversal in symmetric Latin square using lower-triangular grid:\n"
+        "-sttr <triangular_input>\n"
         "Count transversals in symmetric Latin squares using lower-triangular grid:\n"
         "-sttc <triangular_input>\n"
         "Find minimum and maximum transversals in symmetric Latin squares using lower-triangular grid:\n"
         "-sttm <size> <type>\n"
         "Find minimum and maximum transversals in symmetric Latin squares for template using lower-triangular grid:\n"
         "-sttt <triangular_input>\n\n"
+        "Merge results of sharded runs:\n"
+        "-merge <shard_output>...\n"
+        "Answer requests (one command line per line) from standard input or Unix domain socket:\n"
+        "--serve [<socket>]\n\n"
         "<size> -- number between 1 and 64, representing the order of the Latin square\n"
         "<type> -- character indicating the Latin square type: "
         "N (normal), R (reduced), C (reduced cyclic), D (reduced diagonal)\n"
@@ -102,7 +144,31 @@ namespace LatinSquare {
         "cells contain numbers 1 to <size> or 0 for empty\n"
         "<full_input> -- file containing complete Latin square with <size> rows and columns, "
         "cells contain numbers 1 to <size>\n"
-        "<output> -- file path to save generated Latin squares or results\n";
+        "Input files can be replaced with - to read from standard input. -tc, -stc and -sttc accept several squares "
+        "separated by empty lines and print the number of transversals for each of them, "
+        "reporting and skipping every block that is not a complete square\n"
+        "<output> -- file path to save generated Latin squares or results, "
+        "-te saves every transversal as <size> bytes, the column (from 0) of its cell in each row\n"
+        "<count> -- with -trb, number of random transversals printed one per line as the columns (from 1) "
+        "of their cells in each row\n"
+        "<shard_output> -- file containing output of -lc, -ltc, -tm or -tt run with --shard\n"
+        "<socket> -- path of Unix domain socket to listen on, every response ends with line END\n"
+        "--no-cache -- optional last argument, disables the result cache of counting and minimum/maximum modes "
+        "(stored in $LATIN_SQUARE_CACHE or ~/.latinsquare_cache)\n"
+        "--shard <index>/<count> -- optional suffix for -lc, -ltc, -tm and -tt, "
+        "explores only the part of the search space with number <index> (from 0 to <count> - 1)\n"
+        "--gac -- optional suffix for -ltr, -ltf and -ltc, filters the possible numbers of every row and column "
+        "with all-different matching after each step of the search\n"
+        "--cbj -- optional suffix for -ltr and -ltf (not together with --gac), jumps back to the latest number "
+        "that caused a dead end and remembers combinations of numbers that cannot be completed\n"
+        "--distinct -- optional suffix for -trb, prints only different transversals "
+        "(fewer if the square does not have <count>)\n"
+        "--count -- optional suffix for -tp, also counts partial transversals of maximum length\n"
+        "--threads <count> -- optional suffix for -trb, -te, -sttc and -sttm, "
+        "splits the search between <count> threads "
+        "(-te saves the transversals found by each thread to <output>.<thread>)\n"
+        "--squares <count> -- optional suffix for -lf, -ltf, -slf and -sltf, "
+        "saves <count> random Latin squares to <output>, separated by empty lines\n";
 
     static constexpr std::string_view TIME = "Time: ";
     static constexpr std::string_view SECONDS = " seconds\n";
@@ -0,0 +1,256 @@
+#include "Formatter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+
+#include <cpp/iostream.hpp>
+
+namespace LatinSquare {
+    Formatter::Formatter(const uint_fast8_t size) noexcept : size_(size) {
+        std::array<char, 4> digits;
+        const auto width = std::to_chars(digits.data(), digits.data() + digits.size(), size_ + 0u).ptr - digits.data();
+        shortBar_ = std::string(width + 2, '-');
+        longBar_ = std::string(width + 4, '-');
+        longBar_.front() = '+';
+        longBar_.back() = '+';
+        rightBar_ = std::string(width + 3, '-');
+        rightBar_.back() = '+';
+        leftBarSize_ = shortBar_.size() + 1;
+        bars_.reserve(leftBarSize_ * size_);
+
+        for (uint_fast8_t index = 0; index < size_; ++index) {
+            bars_.push_back('+');
+            bars_.append(shortBar_);
+        }
+
+        highlightOn_ = cpp::bold_on();
+        highlightOn_.append(cpp::green_on());
+        highlightOff_ = cpp::reset();
+        cells_.reserve(size_ + 1);
+        numbers_.reserve(size_ + 1);
+
+        // Index size_ holds the text of an empty cell, so a partially filled grid is printed with zeros.
+        for (uint_fast8_t index = 0; index <= size_; ++index) {
+            const auto number = index < size_ ? index + 1u : 0u;
+            const auto length = std::to_chars(digits.data(), digits.data() + digits.size(), number).ptr - digits.data();
+            cells_.emplace_back(width - length + 1, ' ');
+            cells_.back().append(digits.data(), length);
+            cells_.back().push_back(' ');
+            numbers_.emplace_back(digits.data(), length);
+            numbers_.back().push_back(' ');
+        }
+
+        buffer_.reserve((2 * size_ + 1) * (leftBarSize_ * size_ + 2));
+    }
+
+    void Formatter::board(const std::vector<std::shared_ptr<Cell>>& grid) noexcept {
+        for (const auto& cell : grid) {
+            if (cell->rawColumn() == 0) {
+                bars(size_);
+                buffer_.push_back('+');
+                buffer_.push_back('\n');
+            }
+
+            buffer_.push_back('|');
+            buffer_.append(cells_[std::min(cell->number(), size_)]);
+
+            if (cell->rawColumn() == size_ - 1) {
+                buffer_.push_back('|');
+                buffer_.push_back('\n');
+            }
+        }
+
+        bars(size_);
+        buffer_.push_back('+');
+        buffer_.push_back('\n');
+    }
+
+    void Formatter::board(
+        const std::vector<std::shared_ptr<Cell>>& grid, const std::vector<uint_fast16_t>& transversal) noexcept {
+        auto isTransversalCell = false, isTransversalPreviousCell = false;
+        uint_fast8_t index = 0, column = 0, previousColumn = 0, difference = 0;
+
+        for (const auto& cell : grid) {
+            isTransversalCell = (transversal[index] == cell->index());
+
+            if (cell->rawColumn() == 0) {
+                column = grid[transversal[index]]->rawColumn();
+
+                if (cell->rawRow() == 0) {
+                    bars(column);
+                    highlight(longBar_);
+                    closingBars(column);
+                } else {
+                    const auto [firstColumn, secondColumn] = std::minmax(previousColumn, column);
+                    difference = secondColumn - firstColumn - 1;
+                    bars(firstColumn);
+                    highlight(longBar_);
+
+                    if (difference == 0) {
+                        highlight(rightBar_);
+                    } else {
+                        buffer_.append(shortBar_);
+                        bars(difference - 1);
+                        highlight(longBar_);
+                    }
+
+                    closingBars(secondColumn);
+                }
+            }
+
+            if (isTransversalCell) {
+                buffer_.append(highlightOn_);
+                buffer_.push_back('|');
+                buffer_.append(cells_[std::min(cell->number(), size_)]);
+                buffer_.push_back('|');
+                buffer_.append(highlightOff_);
+            } else {
+                if (!isTransversalPreviousCell) {
+                    buffer_.push_back('|');
+                }
+
+                buffer_.append(cells_[std::min(cell->number(), size_)]);
+            }
+
+            if (cell->rawColumn() == size_ - 1) {
+                if (!isTransversalCell) {
+                    buffer_.push_back('|');
+                }
+
+                buffer_.push_back('\n');
+                isTransversalPreviousCell = false;
+                previousColumn = column;
+                ++index;
+            } else {
+                isTransversalPreviousCell = isTransversalCell;
+            }
+        }
+
+        bars(column);
+        highlight(longBar_);
+        closingBars(column);
+    }
+
+    // Rows of a partial transversal may have no chosen cell, so only the numbers of its cells are highlighted.
+    void Formatter::partialBoard(
+        const std::vector<std::shared_ptr<Cell>>& grid, const std::vector<uint_fast16_t>& transversal) noexcept {
+        for (const auto& cell : grid) {
+            if (cell->rawColumn() == 0) {
+                bars(size_);
+                buffer_.push_back('+');
+                buffer_.push_back('\n');
+            }
+
+            buffer_.push_back('|');
+
+            if (std::binary_search(transversal.begin(), transversal.end(), cell->index())) {
+                highlight(cells_[std::min(cell->number(), size_)]);
+            } else {
+                buffer_.append(cells_[std::min(cell->number(), size_)]);
+            }
+
+            if (cell->rawColumn() == size_ - 1) {
+                buffer_.push_back('|');
+                buffer_.push_back('\n');
+            }
+        }
+
+        bars(size_);
+        buffer_.push_back('+');
+        buffer_.push_back('\n');
+    }
+
+    void Formatter::triangularBoard(const std::vector<std::shared_ptr<Cell>>& triangularGrid) noexcept {
+        uint_fast16_t index = -1;
+
+        for (uint_fast8_t row = 0; row < size_; ++row) {
+            bars(row + 1);
+            buffer_.push_back('+');
+            buffer_.push_back('\n');
+
+            for (uint_fast8_t column = 0; column <= row; ++column) {
+                buffer_.push_back('|');
+                buffer_.append(cells_[std::min(triangularGrid[++index]->number(), size_)]);
+            }
+
+            buffer_.push_back('|');
+            buffer_.push_back('\n');
+        }
+
+        bars(size_);
+        buffer_.push_back('+');
+        buffer_.push_back('\n');
+    }
+
+    void Formatter::triangularBoard(const std::vector<std::shared_ptr<Cell>>& triangularGrid,
+        const std::vector<uint_fast16_t>& transversal) noexcept {
+        uint_fast16_t index = -1;
+
+        for (uint_fast8_t row = 0; row < size_; ++row) {
+            bars(row + 1);
+            buffer_.push_back('+');
+            buffer_.push_back('\n');
+
+            for (uint_fast8_t column = 0; column <= row; ++column) {
+                const auto& cell = triangularGrid[++index];
+                buffer_.push_back('|');
+
+                if (std::binary_search(transversal.begin(), transversal.end(), cell->index())) {
+                    highlight(cells_[std::min(cell->number(), size_)]);
+                } else {
+                    buffer_.append(cells_[std::min(cell->number(), size_)]);
+                }
+            }
+
+            buffer_.push_back('|');
+            buffer_.push_back('\n');
+        }
+
+        bars(size_);
+        buffer_.push_back('+');
+        buffer_.push_back('\n');
+    }
+
+    void Formatter::file(const std::vector<std::shared_ptr<Cell>>& grid) noexcept {
+        for (const auto& cell : grid) {
+            buffer_.append(numbers_[std::min(cell->number(), size_)]);
+
+            if (cell->rawColumn() == size_ - 1) {
+                buffer_.push_back('\n');
+            }
+        }
+    }
+
+    void Formatter::triangularFile(const std::vector<std::shared_ptr<Cell>>& triangularGrid) noexcept {
+        uint_fast16_t index = -1;
+
+        for (uint_fast8_t row = 0; row < size_; ++row) {
+            for (uint_fast8_t column = 0; column <= row; ++column) {
+                buffer_.append(numbers_[std::min(triangularGrid[++index]->number(), size_)]);
+            }
+
+            buffer_.push_back('\n');
+        }
+    }
+
+    void Formatter::write(std::ostream& stream) noexcept {
+        stream.write(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+
+    void Formatter::write(Writer& writer) noexcept {
+        writer.write(buffer_);
+        buffer_.clear();
+    }
+
+    void Formatter::closingBars(const uint_fast8_t column) noexcept {
+        if (column != size_ - 1) {
+            buffer_.append(shortBar_);
+            bars(size_ - column - 2);
+            buffer_.push_back('+');
+        }
+
+        buffer_.push_back('\n');
+    }
+}
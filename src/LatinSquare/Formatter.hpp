@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Cell.hpp"
+#include "Writer.hpp"
+
+namespace LatinSquare {
+    class Formatter {
+        public:
+            explicit Formatter(const uint_fast8_t size) noexcept;
+
+            [[nodiscard]] inline constexpr uint_fast8_t size() const noexcept {
+                return size_;
+            }
+
+            [[nodiscard]] inline const std::string& buffer() const noexcept {
+                return buffer_;
+            }
+
+            inline void clear() noexcept {
+                buffer_.clear();
+            }
+
+            void board(const std::vector<std::shared_ptr<Cell>>& grid) noexcept;
+            void board(const std::vector<std::shared_ptr<Cell>>& grid,
+                const std::vector<uint_fast16_t>& transversal) noexcept;
+            void partialBoard(const std::vector<std::shared_ptr<Cell>>& grid,
+                const std::vector<uint_fast16_t>& transversal) noexcept;
+            void triangularBoard(const std::vector<std::shared_ptr<Cell>>& triangularGrid) noexcept;
+            void triangularBoard(const std::vector<std::shared_ptr<Cell>>& triangularGrid,
+                const std::vector<uint_fast16_t>& transversal) noexcept;
+            void file(const std::vector<std::shared_ptr<Cell>>& grid) noexcept;
+            void triangularFile(const std::vector<std::shared_ptr<Cell>>& triangularGrid) noexcept;
+            void write(std::ostream& stream) noexcept;
+            void write(Writer& writer) noexcept;
+
+        private:
+            inline void bars(const uint_fast8_t count) noexcept {
+                buffer_.append(bars_, 0, count * leftBarSize_);
+            }
+
+            inline void highlight(const std::string_view string) noexcept {
+                buffer_.append(highlightOn_);
+                buffer_.append(string);
+                buffer_.append(highlightOff_);
+            }
+
+            void closingBars(const uint_fast8_t column) noexcept;
+
+            uint_fast8_t size_;
+            size_t leftBarSize_;
+            std::string shortBar_;
+            std::string longBar_;
+            std::string rightBar_;
+            std::string bars_;
+            std::string highlightOn_;
+            std::string highlightOff_;
+            std::vector<std::string> cells_;
+            std::vector<std::string> numbers_;
+            std::string buffer_;
+    };
+}
@@ -2,10 +2,14 @@
 
 // #include <iostream>
 
+#include <algorithm>
+#include <bit>
+
 #include <cpp/random.hpp>
 
 #include "Cell.hpp"
 #include "EntropyData.hpp"
+#include "Utils.hpp"
 
 namespace LatinSquare {
     const LatinSquare Generator::random(const uint_fast8_t size, const Type type) noexcept {
@@ -16,6 +20,8 @@ namespace LatinSquare {
         uint_fast8_t number;
         EntropyData entropyData;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(latinSquare.notFilled());
         backtrackingHistory_.reserve(latinSquare.notFilled());
 
@@ -66,6 +72,8 @@ namespace LatinSquare {
 
                 updateHistory_.clear();
                 backtrackingHistory_.clear();
+                index = DEFAULT_CELL_INDEX;
+                counter = 0;
                 iterations = 0;
             }
         }
@@ -74,13 +82,24 @@ namespace LatinSquare {
     }
 
     const LatinSquare Generator::random(const uint_fast8_t size, const std::vector<uint_fast8_t>& numbers) noexcept {
+        if (backjumping_) {
+            return backjumpingRandom(size, numbers);
+        }
+
         cpp::splitmix64 splitmix64;
         LatinSquare latinSquare(size, numbers, splitmix64);
+        latinSquare.propagation(propagation_);
+
+        if (!latinSquare.completable()) {
+            return latinSquare;
+        }
 
         uint_fast16_t index = DEFAULT_CELL_INDEX;
         uint_fast8_t number;
         EntropyData entropyData;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(latinSquare.notFilled());
         backtrackingHistory_.reserve(latinSquare.notFilled());
 
@@ -103,6 +122,18 @@ namespace LatinSquare {
                 if (backtrackingHistory_.empty() || cell.index() != backtrackingHistory_.back().index()) {
                     backtrackingHistory_.emplace_back(cell.index(), entropyData);
                 }
+
+                if (!latinSquare.propagate()) {
+                    counter = 1;
+
+                    index = updateHistory_.back().index();
+
+                    latinSquare.unpropagate();
+                    latinSquare.clearAndRemove(index, updateHistory_.back().entropyData());
+                    latinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
+
+                    updateHistory_.pop_back();
+                }
             } else {
                 if (updateHistory_.empty()) {
                     break;
@@ -120,6 +151,7 @@ namespace LatinSquare {
 
                 index = updateHistory_.back().index();
 
+                latinSquare.unpropagate();
                 latinSquare.clearAndRemove(index, updateHistory_.back().entropyData());
                 latinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
 
@@ -128,9 +160,12 @@ namespace LatinSquare {
 
             if (++iterations > MAX_ITERATIONS) {
                 latinSquare.set(numbers);
+                static_cast<void>(latinSquare.completable());
 
                 updateHistory_.clear();
                 backtrackingHistory_.clear();
+                index = DEFAULT_CELL_INDEX;
+                counter = 0;
                 iterations = 0;
             }
         }
@@ -138,37 +173,196 @@ namespace LatinSquare {
         return latinSquare;
     }
 
+    const LatinSquare Generator::backjumpingRandom(
+        const uint_fast8_t size, const std::vector<uint_fast8_t>& numbers) noexcept {
+        cpp::splitmix64 splitmix64;
+        LatinSquare latinSquare(size, numbers, splitmix64);
+
+        if (!latinSquare.completable()) {
+            return latinSquare;
+        }
+
+        const uint_fast16_t gridSize = latinSquare.grid().size();
+        const uint_fast64_t allNumbers = size < MAX_SIZE ? (1ULL << size) - 1 : 0xFFFFFFFFFFFFFFFF;
+        uint_fast16_t index = DEFAULT_CELL_INDEX;
+        uint_fast8_t number;
+        EntropyData entropyData;
+
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
+        updateHistory_.reserve(latinSquare.notFilled());
+        backtrackingHistory_.reserve(latinSquare.notFilled());
+
+        conflictWords_ = (gridSize + 63) >> 6;
+        killers_.assign(gridSize * size, DEFAULT_CELL_INDEX);
+        conflicts_.assign(gridSize * conflictWords_, 0);
+        conflict_.resize(conflictWords_);
+        nogoods_.reset(gridSize);
+
+        uint_fast32_t iterations = 0;
+
+        while (latinSquare.notFilled()) {
+            auto& cell = latinSquare.randomMinEntropyCell(index);
+
+            if (cell.positiveEntropy()) {
+                index = DEFAULT_CELL_INDEX;
+
+                number = cell.numbers()[splitmix64.next() % cell.numbers().size()];
+                entropyData = cell.entropyData();
+                latinSquare.fillAndClear(cell, number);
+
+                updateHistory_.emplace_back(cell.index(), number, entropyData, latinSquare.update(cell, number));
+
+                if (backtrackingHistory_.empty() || cell.index() != backtrackingHistory_.back().index()) {
+                    backtrackingHistory_.emplace_back(cell.index(), entropyData);
+                }
+
+                for (const auto updateIndex : updateHistory_.back().indexes()) {
+                    killers_[updateIndex * size + number] = cell.index();
+                }
+
+                if (nogoods_.find(cell, latinSquare, conflict_) && !backjump(latinSquare, index, false)) {
+                    break;
+                }
+            } else {
+                std::fill(conflict_.begin(), conflict_.end(), 0);
+
+                // A cell forced after its failed numbers is explained by their conflicts and by the numbers removed
+                // before its first fill, any other cell without numbers only by the cells that removed them.
+                if (index < DEFAULT_CELL_INDEX) {
+                    const auto& firstEntropyData = backtrackingHistory_.back().entropyData();
+                    addConflict(index, latinSquare.size(), allNumbers & ~firstEntropyData.positiveEntropy());
+
+                    for (uint_fast16_t word = 0; word < conflictWords_; ++word) {
+                        conflict_[word] |= conflicts_[index * conflictWords_ + word];
+                        conflicts_[index * conflictWords_ + word] = 0;
+                    }
+
+                    latinSquare.set(index, firstEntropyData);
+                    backtrackingHistory_.pop_back();
+                } else {
+                    addConflict(cell.index(), latinSquare.size(), allNumbers & ~cell.positiveEntropy());
+                }
+
+                if (!backjump(latinSquare, index, true)) {
+                    break;
+                }
+            }
+
+            if (++iterations > MAX_ITERATIONS) {
+                latinSquare.set(numbers);
+                static_cast<void>(latinSquare.completable());
+
+                updateHistory_.clear();
+                backtrackingHistory_.clear();
+                std::fill(conflicts_.begin(), conflicts_.end(), 0);
+                index = DEFAULT_CELL_INDEX;
+                iterations = 0;
+            }
+        }
+
+        return latinSquare;
+    }
+
+    void Generator::addConflict(const uint_fast16_t index, const uint_fast8_t size, uint_fast64_t numbers) noexcept {
+        for (; numbers; numbers &= numbers - 1) {
+            const auto killer = killers_[index * size + std::countr_zero(numbers)];
+
+            // Numbers removed by the template itself do not depend on any choice of the search.
+            if (killer != DEFAULT_CELL_INDEX) {
+                conflict_[killer >> 6] |= 1ULL << (killer & 63);
+            }
+        }
+    }
+
+    bool Generator::backjump(LatinSquare& latinSquare, uint_fast16_t& index, const bool learn) noexcept {
+        if (std::all_of(conflict_.begin(), conflict_.end(), [](const uint_fast64_t word) { return !word; })) {
+            return false;
+        }
+
+        index = updateHistory_.back().index();
+
+        while (!(conflict_[index >> 6] & (1ULL << (index & 63)))) {
+            latinSquare.clear(index, backtrackingHistory_.back().entropyData());
+            latinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
+
+            std::fill_n(conflicts_.begin() + index * conflictWords_, conflictWords_, 0);
+            backtrackingHistory_.pop_back();
+            updateHistory_.pop_back();
+            index = updateHistory_.back().index();
+        }
+
+        if (learn) {
+            nogoods_.insert(conflict_, index, latinSquare);
+        }
+
+        conflict_[index >> 6] &= ~(1ULL << (index & 63));
+
+        for (uint_fast16_t word = 0; word < conflictWords_; ++word) {
+            conflicts_[index * conflictWords_ + word] |= conflict_[word];
+        }
+
+        latinSquare.clearAndRemove(index, updateHistory_.back().entropyData());
+        latinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
+
+        updateHistory_.pop_back();
+
+        return true;
+    }
+
     const boost::multiprecision::mpz_int Generator::count(const uint_fast8_t size, const Type type) noexcept {
+        // With the first row fixed, every square is counted once for each of the (size - 1)! first columns.
+        if ((type == Type::Normal || type == Type::Reduced) && shardsCount_ == 1 && size > 2
+            && size <= MAX_RECTANGLE_SIZE) {
+            std::vector<uint_fast64_t> columns(size);
+
+            for (uint_fast8_t column = 0; column < size; ++column) {
+                columns[column] = 1ULL << column;
+            }
+
+            const auto result = rectangleCounter_.count(size, columns, 1);
+            return type == Type::Normal ? factorial(size) * result : result / factorial(size - 1);
+        }
+
         LatinSquare latinSquare(size, type);
+        // Only the diagonals break the symmetry between cells and symbols enough for the symbol regions to pay off.
+        latinSquare.symbolRegions(type == Type::ReducedDiagonal);
 
         if (latinSquare.notFilled() < 2) {
             // std::cout << "Iterations: 1" << std::endl;
 
-            return 1;
+            return inShard(0) ? 1 : 0;
+        }
+
+        if (latinSquare.lastLines()) {
+            return inShard(0) ? latinSquare.lastLinesCount() : 0;
         }
 
         uint_fast16_t index = DEFAULT_CELL_INDEX;
         uint_fast8_t number;
         EntropyData entropyData;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(latinSquare.notFilled());
         backtrackingHistory_.reserve(latinSquare.notFilled());
 
         boost::multiprecision::mpz_int latinSquaresCounter = 0;
         uint_fast16_t counter = 0;
+        shardNode_ = 0;
         // boost::multiprecision::mpz_int iterations = 0;
 
         while (true) {
             // ++iterations;
 
-            if (latinSquare.notFilled() > 1) {
-                auto& cell = latinSquare.minEntropyCell(index);
+            if (latinSquare.notFilled() > 1 && !latinSquare.lastLines()) {
+                auto& cell = latinSquare.minEntropyCellOrLine(index);
 
                 if (cell.positiveEntropy()) {
                     index = DEFAULT_CELL_INDEX;
                     counter = 0;
 
-                    number = cell.firstNumber();
+                    number = latinSquare.minNumber();
                     entropyData = cell.entropyData();
                     latinSquare.fillAndClear(cell, number);
 
@@ -177,6 +371,17 @@ namespace LatinSquare {
                     if (backtrackingHistory_.empty() || cell.index() != backtrackingHistory_.back().index()) {
                         backtrackingHistory_.emplace_back(cell.index(), entropyData);
                     }
+
+                    if (notInShard(updateHistory_.size())) {
+                        counter = 1;
+
+                        index = updateHistory_.back().index();
+
+                        latinSquare.clearAndRemove(index, updateHistory_.back().entropyData());
+                        latinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
+
+                        updateHistory_.pop_back();
+                    }
                 } else {
                     if (updateHistory_.empty()) {
                         break;
@@ -201,7 +406,11 @@ namespace LatinSquare {
                 }
             } else {
                 counter = 1;
-                latinSquaresCounter += latinSquare.lastNotFilledCell().entropy();
+
+                if (inShard(updateHistory_.size())) {
+                    latinSquaresCounter += latinSquare.lastLines()
+                        ? latinSquare.lastLinesCount() : latinSquare.lastNotFilledCell().entropy();
+                }
 
                 index = updateHistory_.back().index();
 
@@ -218,29 +427,62 @@ namespace LatinSquare {
     }
 
     const boost::multiprecision::mpz_int Generator::count(LatinSquare& latinSquare) noexcept {
+        latinSquare.propagation(propagation_);
+
+        if (!latinSquare.completable()) {
+            return 0;
+        }
+
         if (latinSquare.notFilled() < 2) {
-            return 1;
+            return inShard(0) ? 1 : 0;
+        }
+
+        if (latinSquare.lastLines()) {
+            return inShard(0) ? latinSquare.lastLinesCount() : 0;
         }
 
+        if (shardsCount_ == 1 && completeRows(latinSquare)) {
+            const auto size = latinSquare.size();
+            std::vector<uint_fast64_t> columns(size, 0);
+            uint_fast8_t rows = 0;
+
+            for (uint_fast8_t row = 0; row < size; ++row) {
+                if (latinSquare.grid()[row * size]->filled()) {
+                    for (uint_fast8_t column = 0; column < size; ++column) {
+                        columns[column] |= 1ULL << latinSquare.grid()[row * size + column]->number();
+                    }
+
+                    ++rows;
+                }
+            }
+
+            return rectangleCounter_.count(size, columns, rows);
+        }
+
+        // Numbers with a single place left in a line prune enough to pay for their bookkeeping only on larger squares.
+        latinSquare.symbolRegions(latinSquare.size() >= SYMBOL_REGIONS_MIN_SIZE);
         uint_fast16_t index = DEFAULT_CELL_INDEX;
         uint_fast8_t number;
         EntropyData entropyData;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(latinSquare.notFilled());
         backtrackingHistory_.reserve(latinSquare.notFilled());
 
         boost::multiprecision::mpz_int latinSquaresCounter = 0;
         uint_fast16_t counter = 0;
+        shardNode_ = 0;
 
         while (true) {
-            if (latinSquare.notFilled() > 1) {
-                auto& cell = latinSquare.minEntropyCell(index);
+            if (latinSquare.notFilled() > 1 && !latinSquare.lastLines()) {
+                auto& cell = latinSquare.minEntropyCellOrLine(index);
 
                 if (cell.positiveEntropy()) {
                     index = DEFAULT_CELL_INDEX;
                     counter = 0;
 
-                    number = cell.firstNumber();
+                    number = latinSquare.minNumber();
                     entropyData = cell.entropyData();
                     latinSquare.fillAndClear(cell, number);
 
@@ -249,6 +491,27 @@ namespace LatinSquare {
                     if (backtrackingHistory_.empty() || cell.index() != backtrackingHistory_.back().index()) {
                         backtrackingHistory_.emplace_back(cell.index(), entropyData);
                     }
+
+                    if (notInShard(updateHistory_.size())) {
+                        counter = 1;
+
+                        index = updateHistory_.back().index();
+
+                        latinSquare.clearAndRemove(index, updateHistory_.back().entropyData());
+                        latinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
+
+                        updateHistory_.pop_back();
+                    } else if (!latinSquare.propagate()) {
+                        counter = 1;
+
+                        index = updateHistory_.back().index();
+
+                        latinSquare.unpropagate();
+                        latinSquare.clearAndRemove(index, updateHistory_.back().entropyData());
+                        latinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
+
+                        updateHistory_.pop_back();
+                    }
                 } else {
                     if (updateHistory_.empty()) {
                         break;
@@ -266,6 +529,7 @@ namespace LatinSquare {
 
                     index = updateHistory_.back().index();
 
+                    latinSquare.unpropagate();
                     latinSquare.clearAndRemove(index, updateHistory_.back().entropyData());
                     latinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
 
@@ -273,10 +537,15 @@ namespace LatinSquare {
                 }
             } else {
                 counter = 1;
-                latinSquaresCounter += latinSquare.lastNotFilledCell().entropy();
+
+                if (inShard(updateHistory_.size())) {
+                    latinSquaresCounter += latinSquare.lastLines()
+                        ? latinSquare.lastLinesCount() : latinSquare.lastNotFilledCell().entropy();
+                }
 
                 index = updateHistory_.back().index();
 
+                latinSquare.unpropagate();
                 latinSquare.clearAndRemove(index, updateHistory_.back().entropyData());
                 latinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
 
@@ -299,6 +568,8 @@ namespace LatinSquare {
         uint_fast8_t number;
         EntropyData entropyData;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(symmetricLatinSquare.notFilled());
         backtrackingHistory_.reserve(symmetricLatinSquare.notFilled());
 
@@ -323,6 +594,17 @@ namespace LatinSquare {
                     if (backtrackingHistory_.empty() || cell.index() != backtrackingHistory_.back().index()) {
                         backtrackingHistory_.emplace_back(cell.index(), entropyData);
                     }
+
+                    if (!symmetricLatinSquare.diagonalFeasible()) {
+                        counter = 1;
+
+                        index = updateHistory_.back().index();
+
+                        symmetricLatinSquare.clearAndRemove(index, updateHistory_.back().entropyData());
+                        symmetricLatinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
+
+                        updateHistory_.pop_back();
+                    }
                 } else {
                     if (updateHistory_.empty()) {
                         break;
@@ -365,6 +647,8 @@ namespace LatinSquare {
 
                 updateHistory_.clear();
                 backtrackingHistory_.clear();
+                index = DEFAULT_CELL_INDEX;
+                counter = 0;
                 iterations = 0;
             }
         }
@@ -381,6 +665,8 @@ namespace LatinSquare {
         uint_fast8_t number;
         EntropyData entropyData;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(symmetricLatinSquare.notFilled());
         backtrackingHistory_.reserve(symmetricLatinSquare.notFilled());
 
@@ -405,6 +691,17 @@ namespace LatinSquare {
                     if (backtrackingHistory_.empty() || cell.index() != backtrackingHistory_.back().index()) {
                         backtrackingHistory_.emplace_back(cell.index(), entropyData);
                     }
+
+                    if (!symmetricLatinSquare.diagonalFeasible()) {
+                        counter = 1;
+
+                        index = updateHistory_.back().index();
+
+                        symmetricLatinSquare.clearAndRemove(index, updateHistory_.back().entropyData());
+                        symmetricLatinSquare.restore(updateHistory_.back().indexes(), updateHistory_.back().number());
+
+                        updateHistory_.pop_back();
+                    }
                 } else {
                     if (updateHistory_.empty()) {
                         break;
@@ -447,6 +744,8 @@ namespace LatinSquare {
 
                 updateHistory_.clear();
                 backtrackingHistory_.clear();
+                index = DEFAULT_CELL_INDEX;
+                counter = 0;
                 iterations = 0;
             }
         }
@@ -455,6 +754,14 @@ namespace LatinSquare {
     }
 
     const boost::multiprecision::mpz_int Generator::symmetricCount(const uint_fast8_t size, const Type type) noexcept {
+        if (type == Type::Normal) {
+            return factorial(size) * symmetricCount(size, Type::Reduced);
+        }
+
+        if (type == Type::Reduced && size > 2) {
+            return symmetricReducedCount(size);
+        }
+
         SymmetricLatinSquare symmetricLatinSquare(size, type);
 
         if (type == Type::ReducedDiagonal) {
@@ -473,6 +780,8 @@ namespace LatinSquare {
         uint_fast8_t number;
         EntropyData entropyData;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(symmetricLatinSquare.notFilled());
         backtrackingHistory_.reserve(symmetricLatinSquare.notFilled());
 
@@ -541,6 +850,51 @@ namespace LatinSquare {
         return latinSquaresCounter;
     }
 
+    // Only templates whose rows are either full or empty are Latin rectangles, with no other constraint on the rest.
+    bool Generator::completeRows(const LatinSquare& latinSquare) const noexcept {
+        const auto size = latinSquare.size();
+
+        if (size > MAX_RECTANGLE_SIZE) {
+            return false;
+        }
+
+        for (uint_fast8_t row = 0; row < size; ++row) {
+            const auto filled = latinSquare.grid()[row * size]->filled();
+
+            for (uint_fast8_t column = 1; column < size; ++column) {
+                if (latinSquare.grid()[row * size + column]->filled() != filled) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Counting rows, columns and numbers from 0, cell (1, 1) holds 0 or some k >= 2. Swapping rows and columns 2 and k
+    // together with numbers 2 and k keeps the first column reduced and turns k in that cell into 2, so every k >= 2
+    // completes to the same number of squares.
+    const boost::multiprecision::mpz_int Generator::symmetricReducedCount(const uint_fast8_t size) noexcept {
+        std::vector<uint_fast8_t> numbers;
+
+        for (uint_fast8_t row = 0; row < size; ++row) {
+            numbers.emplace_back(row);
+            numbers.resize(numbers.size() + row, EMPTY);
+        }
+
+        numbers[2] = 0;
+        SymmetricLatinSquare identitySymmetricLatinSquare(size, numbers);
+        const auto identityCount = symmetricCount(identitySymmetricLatinSquare);
+
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
+
+        numbers[2] = 2;
+        SymmetricLatinSquare symmetricLatinSquare(size, numbers);
+
+        return identityCount + (size - 2) * symmetricCount(symmetricLatinSquare);
+    }
+
     const boost::multiprecision::mpz_int Generator::symmetricCount(
         SymmetricLatinSquare& symmetricLatinSquare) noexcept {
         if (!symmetricLatinSquare.notFilled()) {
@@ -551,6 +905,8 @@ namespace LatinSquare {
         uint_fast8_t number;
         EntropyData entropyData;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(symmetricLatinSquare.notFilled());
         backtrackingHistory_.reserve(symmetricLatinSquare.notFilled());
 
@@ -8,6 +8,8 @@
 #include "BacktrackingData.hpp"
 #include "Constants.hpp"
 #include "LatinSquare.hpp"
+#include "Nogoods.hpp"
+#include "RectangleCounter.hpp"
 #include "SymmetricLatinSquare.hpp"
 #include "UpdateData.hpp"
 
@@ -30,8 +32,48 @@ namespace LatinSquare {
             [[nodiscard]] const boost::multiprecision::mpz_int symmetricCount(
                 SymmetricLatinSquare& symmetricLatinSquare) noexcept;
 
+            inline constexpr void shard(const uint_fast32_t index, const uint_fast32_t count) noexcept {
+                shardIndex_ = index;
+                shardsCount_ = count;
+            }
+
+            inline constexpr void propagation(const bool propagation) noexcept {
+                propagation_ = propagation;
+            }
+
+            inline constexpr void backjumping(const bool backjumping) noexcept {
+                backjumping_ = backjumping;
+            }
+
         private:
+            [[nodiscard]] const LatinSquare backjumpingRandom(
+                const uint_fast8_t size, const std::vector<uint_fast8_t>& numbers) noexcept;
+            void addConflict(const uint_fast16_t index, const uint_fast8_t size, uint_fast64_t numbers) noexcept;
+            [[nodiscard]] bool backjump(LatinSquare& latinSquare, uint_fast16_t& index, const bool learn) noexcept;
+
+            [[nodiscard]] bool completeRows(const LatinSquare& latinSquare) const noexcept;
+            [[nodiscard]] const boost::multiprecision::mpz_int symmetricReducedCount(const uint_fast8_t size) noexcept;
+
+            [[nodiscard]] inline constexpr bool inShard(const size_t depth) const noexcept {
+                return depth >= SHARD_DEPTH || !shardIndex_;
+            }
+
+            [[nodiscard]] inline constexpr bool notInShard(const size_t depth) noexcept {
+                return depth == SHARD_DEPTH && shardNode_++ % shardsCount_ != shardIndex_;
+            }
+
             std::vector<UpdateData> updateHistory_;
             std::vector<BacktrackingData> backtrackingHistory_;
+            uint_fast32_t shardIndex_ = 0;
+            uint_fast32_t shardsCount_ = 1;
+            uint_fast64_t shardNode_;
+            bool propagation_ = false;
+            std::vector<uint_fast16_t> killers_;
+            std::vector<uint_fast64_t> conflicts_;
+            std::vector<uint_fast64_t> conflict_;
+            uint_fast16_t conflictWords_;
+            Nogoods nogoods_;
+            bool backjumping_ = false;
+            RectangleCounter rectangleCounter_;
     };
 }
@@ -1,24 +1,31 @@
 #include "LatinSquare.hpp"
 
+#include <algorithm>
+#include <bit>
+
 namespace LatinSquare {
     LatinSquare::LatinSquare(const uint_fast8_t size, const Type type) noexcept
-        : size_(size) {
+        : size_(size), propagation_(false), propagationRows_(0), propagationColumns_(0),
+          symbolRegions_(false) {
         set(type);
     }
 
     LatinSquare::LatinSquare(const uint_fast8_t size, const Type type, cpp::splitmix64& splitmix64) noexcept
-        : size_(size), splitmix64_(splitmix64) {
+        : size_(size), splitmix64_(splitmix64), propagation_(false), propagationRows_(0), propagationColumns_(0),
+          symbolRegions_(false) {
         set(type);
     }
 
     LatinSquare::LatinSquare(const uint_fast8_t size, const std::vector<uint_fast8_t>& numbers) noexcept
-        : size_(size) {
+        : size_(size), propagation_(false), propagationRows_(0), propagationColumns_(0),
+          symbolRegions_(false) {
         set(numbers);
     }
 
     LatinSquare::LatinSquare(
         const uint_fast8_t size, const std::vector<uint_fast8_t>& numbers, cpp::splitmix64& splitmix64) noexcept
-        : size_(size), splitmix64_(splitmix64) {
+        : size_(size), splitmix64_(splitmix64), propagation_(false), propagationRows_(0), propagationColumns_(0),
+          symbolRegions_(false) {
         set(numbers);
     }
 
@@ -28,6 +35,7 @@ namespace LatinSquare {
             return;
         }
 
+        type_ = type;
         gridSize_ = size_;
         gridSize_ *= size_;
         doubleSize_ = size_;
@@ -38,6 +46,8 @@ namespace LatinSquare {
         notFilled_ = gridSize_;
         grid_.resize(gridSize_);
         updateIndexes_.reserve(maxUpdateSize_);
+        noEntropyCell_ = std::make_shared<Cell>(0, 0, 0, size_, Type::Custom);
+        noEntropyCell_->fillAndClear(0);
         uint_fast16_t row = 0;
         uint_fast16_t column = 0;
 
@@ -59,6 +69,9 @@ namespace LatinSquare {
                 entropyGrid_[++entropyIndex] = grid_[index];
             }
         }
+
+        setNotFilledLines();
+        setPositions();
     }
 
     void LatinSquare::reset() noexcept {
@@ -68,6 +81,9 @@ namespace LatinSquare {
             grid_[index]->reset();
             notFilled_ -= grid_[index]->filled();
         }
+
+        setNotFilledLines();
+        setPositions();
     }
 
     void LatinSquare::set(const std::vector<uint_fast8_t>& numbers) noexcept {
@@ -76,6 +92,7 @@ namespace LatinSquare {
             return;
         }
 
+        type_ = Type::Custom;
         gridSize_ = size_;
         gridSize_ *= size_;
         doubleSize_ = size_;
@@ -86,6 +103,18 @@ namespace LatinSquare {
         notFilled_ = gridSize_;
         grid_.resize(gridSize_);
         updateIndexes_.reserve(maxUpdateSize_);
+        noEntropyCell_ = std::make_shared<Cell>(0, 0, 0, size_, Type::Custom);
+        noEntropyCell_->fillAndClear(0);
+        propagationIndexes_.reserve(gridSize_);
+        propagationNumbers_.reserve(gridSize_);
+        propagationMarks_.reserve(gridSize_);
+        matchingCells_.resize(size_);
+        matchingDomains_.resize(size_);
+        matchingCellNumbers_.resize(size_);
+        matchingNumberCells_.resize(size_);
+        matchingReach_.resize(size_);
+        matchingRows_.assign(gridSize_, EMPTY);
+        matchingColumns_.assign(gridSize_, EMPTY);
         entropyGridSize_ = 0;
         uint_fast16_t row = 0;
         uint_fast16_t column = 0;
@@ -112,6 +141,8 @@ namespace LatinSquare {
                 update(*grid_[index], numbers[index]);
             }
         }
+
+        setNotFilledLines();
     }
 
     void LatinSquare::reset(const std::vector<uint_fast8_t>& numbers) noexcept {
@@ -119,12 +150,70 @@ namespace LatinSquare {
 
         for (uint_fast16_t index = 0; index < gridSize_; ++index) {
             grid_[index]->reset();
+        }
 
+        // Every cell has to be reset before the given numbers are removed from their rows and columns.
+        for (uint_fast16_t index = 0; index < gridSize_; ++index) {
             if (numbers[index] != DEFAULT_NUMBER) {
                 grid_[index]->fillAndClear(numbers[index]);
                 update(*grid_[index], numbers[index]);
             }
         }
+
+        setNotFilledLines();
+    }
+
+    void LatinSquare::setNotFilledLines() noexcept {
+        rowsNotFilled_.assign(size_, 0);
+        columnsNotFilled_.assign(size_, 0);
+        notFilledRows_ = 0;
+        notFilledColumns_ = 0;
+
+        for (const auto& cell : grid_) {
+            if (cell->notFilled()) {
+                notFilledRows_ += !rowsNotFilled_[cell->rawRow()]++;
+                notFilledColumns_ += !columnsNotFilled_[cell->rawColumn()]++;
+            }
+        }
+
+        lastLinesMasks_.resize(doubleSize_);
+        lastLinesSides_.resize(size_);
+        lastLinesEdges_.reserve(maxUpdateSize_);
+        lastLinesNumberEdges_.resize(doubleSize_);
+        lastLinesOrientations_.resize(size_);
+        lastLinesComponent_.reserve(size_);
+        lastLinesStack_.reserve(doubleSize_);
+    }
+
+    void LatinSquare::symbolRegions(const bool symbolRegions) noexcept {
+        symbolRegions_ = symbolRegions;
+        setPositions();
+    }
+
+    void LatinSquare::setPositions() noexcept {
+        if (!symbolRegions_) {
+            return;
+        }
+
+        positions_.assign(doubleSize_ * size_, 0);
+        lineNumbers_.assign(doubleSize_, 0);
+        singlePositions_.assign(doubleSize_, 0);
+        singleLines_.fill(0);
+
+        for (const auto& cell : grid_) {
+            if (cell->filled()) {
+                lineNumbers_[cell->rawRow()] |= 1ULL << cell->number();
+                lineNumbers_[size_ + cell->rawColumn()] |= 1ULL << cell->number();
+            } else {
+                restorePositions(*cell, cell->positiveEntropy());
+            }
+        }
+
+        for (uint_fast8_t line = 0; line < doubleSize_; ++line) {
+            for (uint_fast8_t number = 0; number < size_; ++number) {
+                setSinglePosition(line, number);
+            }
+        }
     }
 
     void LatinSquare::setRegions() noexcept {
@@ -171,20 +260,19 @@ namespace LatinSquare {
         }
     }
 
+    // Every number appears once in each row of a complete square, so a cell whose number changed since the regions
+    // were set takes the position of its row in the region of its new number, and the other cells stay in place.
     void LatinSquare::resetRegions() noexcept {
-        regions_.resize(doubleSize_);
-
-        for (uint_fast8_t index = 0; index < size_; ++index) {
-            numberCells_[index].clear();
-        }
-
         for (auto& cell : grid_) {
-            cell->setRegionNumber();
-            numberCells_[cell->number()].emplace_back(cell);
+            if (cell->regionNumber() != cell->number() + doubleSize_) {
+                cell->setRegionNumber();
+                numberCells_[cell->number()][cell->rawRow()] = cell;
+                regions_[cell->regionNumber()].set(cell->rawRow(), cell);
+            }
         }
 
-        for (uint_fast8_t index = 0; index < size_; ++index) {
-            regions_.emplace_back(index + doubleSize_, numberCells_[index], size_);
+        for (uint_fast16_t index = doubleSize_; index < regionsSize_; ++index) {
+            regions_[index].reset();
         }
     }
 
@@ -234,6 +322,45 @@ namespace LatinSquare {
         // return *entropyGrid_[0];
     }
 
+    Cell& LatinSquare::minEntropyCellOrLine(const uint_fast16_t index) noexcept {
+        auto* minCell = &minEntropyCell(index);
+        minNumber_ = minCell->firstNumber();
+
+        if (!symbolRegions_ || !minCell->positiveEntropy()) {
+            return *minCell;
+        }
+
+        // A number with a single place left in a row or column is placed before any cell with more numbers, a number
+        // without any place ends the branch. A cell kept after a failed number is only checked for the latter.
+        auto single = index < DEFAULT_CELL_INDEX || minCell->entropy() == 1;
+        uint_fast64_t lines, numbers, positions;
+        uint_fast8_t line, number;
+
+        for (uint_fast8_t side = 0; side < 2; ++side) {
+            for (lines = singleLines_[side]; lines; lines &= lines - 1) {
+                line = side * size_ + std::countr_zero(lines);
+
+                for (numbers = singlePositions_[line]; numbers; numbers &= numbers - 1) {
+                    number = std::countr_zero(numbers);
+                    positions = positions_[line * size_ + number];
+
+                    if (!positions) {
+                        return *noEntropyCell_;
+                    }
+
+                    if (!single) {
+                        single = true;
+                        minCell = side ? &(*grid_[std::countr_zero(positions) * size_ + line - size_])
+                                       : &(*grid_[line * size_ + std::countr_zero(positions)]);
+                        minNumber_ = number;
+                    }
+                }
+            }
+        }
+
+        return *minCell;
+    }
+
     Cell& LatinSquare::lastNotFilledCell() noexcept {
         for (auto& cell : entropyGrid_) {
             if (cell->notFilled()) {
@@ -281,14 +408,17 @@ namespace LatinSquare {
         rowIndex *= size_;
         uint_fast16_t columnIndex = cell.rawColumn();
 
+        // The number stays placed in the row and column of the cell, so only the crossing lines of the peers change.
         while (columnIndex < gridSize_) {
             if (grid_[rowIndex]->notFilled() && grid_[rowIndex]->canBeRemoved(number)) {
                 grid_[rowIndex]->remove();
+                removePosition(size_ + grid_[rowIndex]->rawColumn(), number, grid_[rowIndex]->rawRow());
                 updateIndexes_.emplace_back(rowIndex);
             }
 
             if (grid_[columnIndex]->notFilled() && grid_[columnIndex]->canBeRemoved(number)) {
                 grid_[columnIndex]->remove();
+                removePosition(grid_[columnIndex]->rawRow(), number, grid_[columnIndex]->rawColumn());
                 updateIndexes_.emplace_back(columnIndex);
             }
 
@@ -300,6 +430,7 @@ namespace LatinSquare {
             for (uint_fast16_t index = 0; index < gridSize_; index += size_) {
                 if (grid_[index]->notFilled() && grid_[index]->canBeRemoved(number)) {
                     grid_[index]->remove();
+                    removePositions(*grid_[index], 1ULL << number);
                     updateIndexes_.emplace_back(index);
                 }
 
@@ -313,6 +444,7 @@ namespace LatinSquare {
 
                 if (grid_[index]->notFilled() && grid_[index]->canBeRemoved(number)) {
                     grid_[index]->remove();
+                    removePositions(*grid_[index], 1ULL << number);
                     updateIndexes_.emplace_back(index);
                 }
             }
@@ -321,6 +453,407 @@ namespace LatinSquare {
         return updateIndexes_;
     }
 
+    uint_fast64_t LatinSquare::lastLinesCount() noexcept {
+        const bool rows = notFilledRows_ < 3;
+        uint_fast8_t firstLine = DEFAULT_NUMBER;
+        uint_fast8_t line, cross, side;
+        std::fill(lastLinesMasks_.begin(), lastLinesMasks_.end(), 0);
+        std::fill(lastLinesSides_.begin(), lastLinesSides_.end(), 0);
+
+        for (const auto& cell : entropyGrid_) {
+            if (cell->filled()) {
+                continue;
+            }
+
+            line = rows ? cell->rawRow() : cell->rawColumn();
+            cross = rows ? cell->rawColumn() : cell->rawRow();
+
+            if (firstLine == DEFAULT_NUMBER) {
+                firstLine = line;
+            }
+
+            side = line != firstLine;
+            lastLinesMasks_[(cross << 1) + side] = cell->positiveEntropy();
+            lastLinesSides_[cross] |= 1 << side;
+        }
+
+        std::array<uint_fast64_t, 2> used = {0, 0};
+        uint_fast64_t top, bottom, pair;
+        uint_fast8_t first, second, allowed, edge;
+        lastLinesEdges_.clear();
+        std::fill(lastLinesNumberEdges_.begin(), lastLinesNumberEdges_.end(), DEFAULT_NUMBER);
+
+        for (cross = 0; cross < size_; ++cross) {
+            if (lastLinesSides_[cross] == 3) {
+                top = lastLinesMasks_[cross << 1];
+                bottom = lastLinesMasks_[(cross << 1) + 1];
+                pair = top | bottom;
+
+                if (std::popcount(pair) != 2) {
+                    return 0;
+                }
+
+                first = std::countr_zero(pair);
+                second = std::bit_width(pair) - 1;
+                allowed = ((top >> first) & (bottom >> second) & 1) | (((top >> second) & (bottom >> first) & 1) << 1);
+
+                if (!allowed) {
+                    return 0;
+                }
+
+                edge = lastLinesEdges_.size() / 3;
+
+                for (const auto number : {first, second}) {
+                    if (lastLinesNumberEdges_[number << 1] == DEFAULT_NUMBER) {
+                        lastLinesNumberEdges_[number << 1] = edge;
+                    } else if (lastLinesNumberEdges_[(number << 1) + 1] == DEFAULT_NUMBER) {
+                        lastLinesNumberEdges_[(number << 1) + 1] = edge;
+                    } else {
+                        return 0;
+                    }
+                }
+
+                lastLinesEdges_.emplace_back(first);
+                lastLinesEdges_.emplace_back(second);
+                lastLinesEdges_.emplace_back(allowed);
+            } else if (lastLinesSides_[cross]) {
+                side = lastLinesSides_[cross] >> 1;
+                top = lastLinesMasks_[(cross << 1) + side];
+
+                if (!std::has_single_bit(top) || (used[side] & top)) {
+                    return 0;
+                }
+
+                used[side] |= top;
+            }
+        }
+
+        const uint_fast8_t edges = lastLinesEdges_.size() / 3;
+        std::fill(lastLinesOrientations_.begin(), lastLinesOrientations_.begin() + edges, DEFAULT_NUMBER);
+        uint_fast64_t counter = 1;
+        uint_fast8_t componentCounter;
+
+        for (edge = 0; edge < edges; ++edge) {
+            if (lastLinesOrientations_[edge] != DEFAULT_NUMBER) {
+                continue;
+            }
+
+            lastLinesComponent_.clear();
+            lastLinesComponent_.emplace_back(edge);
+            lastLinesOrientations_[edge] = 2;
+
+            for (size_t index = 0; index < lastLinesComponent_.size(); ++index) {
+                for (uint_fast8_t number = 0; number < 2; ++number) {
+                    for (uint_fast8_t slot = 0; slot < 2; ++slot) {
+                        first = lastLinesNumberEdges_[
+                            (lastLinesEdges_[lastLinesComponent_[index] * 3 + number] << 1) + slot];
+
+                        if (first != DEFAULT_NUMBER && lastLinesOrientations_[first] == DEFAULT_NUMBER) {
+                            lastLinesOrientations_[first] = 2;
+                            lastLinesComponent_.emplace_back(first);
+                        }
+                    }
+                }
+            }
+
+            componentCounter = 0;
+
+            for (uint_fast8_t orientation = 0; orientation < 2; ++orientation) {
+                componentCounter += lastLinesOrientation(edge, orientation, used);
+
+                for (const auto index : lastLinesComponent_) {
+                    lastLinesOrientations_[index] = 2;
+                }
+            }
+
+            if (!componentCounter) {
+                return 0;
+            }
+
+            counter *= componentCounter;
+        }
+
+        return counter;
+    }
+
+    bool LatinSquare::lastLinesOrientation(
+        const uint_fast8_t index, const uint_fast8_t orientation, std::array<uint_fast64_t, 2> used) noexcept {
+        lastLinesStack_.clear();
+        lastLinesStack_.emplace_back(index);
+        lastLinesStack_.emplace_back(orientation);
+        uint_fast8_t edge, edgeOrientation, top, bottom, other;
+
+        while (lastLinesStack_.size()) {
+            edgeOrientation = lastLinesStack_.back();
+            lastLinesStack_.pop_back();
+            edge = lastLinesStack_.back();
+            lastLinesStack_.pop_back();
+
+            if (lastLinesOrientations_[edge] == edgeOrientation) {
+                continue;
+            }
+
+            if (lastLinesOrientations_[edge] < 2 || !((lastLinesEdges_[edge * 3 + 2] >> edgeOrientation) & 1)) {
+                return false;
+            }
+
+            top = lastLinesEdges_[edge * 3 + edgeOrientation];
+            bottom = lastLinesEdges_[edge * 3 + 1 - edgeOrientation];
+
+            if (((used[0] >> top) & 1) || ((used[1] >> bottom) & 1)) {
+                return false;
+            }
+
+            used[0] |= 1ULL << top;
+            used[1] |= 1ULL << bottom;
+            lastLinesOrientations_[edge] = edgeOrientation;
+
+            for (uint_fast8_t slot = 0; slot < 2; ++slot) {
+                other = lastLinesNumberEdges_[(top << 1) + slot];
+
+                if (other != DEFAULT_NUMBER && other != edge) {
+                    lastLinesStack_.emplace_back(other);
+                    lastLinesStack_.emplace_back(lastLinesEdges_[other * 3] == top);
+                }
+
+                other = lastLinesNumberEdges_[(bottom << 1) + slot];
+
+                if (other != DEFAULT_NUMBER && other != edge) {
+                    lastLinesStack_.emplace_back(other);
+                    lastLinesStack_.emplace_back(lastLinesEdges_[other * 3] != bottom);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool LatinSquare::completable() noexcept {
+        propagationIndexes_.clear();
+        propagationNumbers_.clear();
+        propagationMarks_.clear();
+        uint_fast64_t rowNumbers, columnNumbers, bit;
+
+        for (uint_fast16_t line = 0; line < size_; ++line) {
+            rowNumbers = 0;
+            columnNumbers = 0;
+
+            for (uint_fast16_t index = 0; index < size_; ++index) {
+                const auto& rowCell = *grid_[line * size_ + index];
+                const auto& columnCell = *grid_[index * size_ + line];
+
+                if (rowCell.filled()) {
+                    bit = 1ULL << rowCell.number();
+
+                    if (rowNumbers & bit) {
+                        return false;
+                    }
+
+                    rowNumbers |= bit;
+                }
+
+                if (columnCell.filled()) {
+                    bit = 1ULL << columnCell.number();
+
+                    if (columnNumbers & bit) {
+                        return false;
+                    }
+
+                    columnNumbers |= bit;
+                }
+            }
+        }
+
+        // Values removed before the search starts hold for every completion, so they are not kept on the trail.
+        propagationRows_ = size_ < MAX_SIZE ? (1ULL << size_) - 1 : 0xFFFFFFFFFFFFFFFF;
+        propagationColumns_ = propagationRows_;
+        const auto result = filter();
+        propagationIndexes_.clear();
+        propagationNumbers_.clear();
+        return result;
+    }
+
+    bool LatinSquare::propagate() noexcept {
+        if (!propagation_) {
+            return true;
+        }
+
+        propagationMarks_.emplace_back(propagationIndexes_.size());
+
+        // The placed number was removed from the peers of its cell, every other line is still filtered.
+        for (const auto index : updateIndexes_) {
+            queue(*grid_[index]);
+        }
+
+        return filter();
+    }
+
+    void LatinSquare::unpropagate() noexcept {
+        if (!propagation_) {
+            return;
+        }
+
+        const auto mark = propagationMarks_.back();
+        propagationMarks_.pop_back();
+
+        while (propagationIndexes_.size() > mark) {
+            grid_[propagationIndexes_.back()]->restore(propagationNumbers_.back());
+            restorePositions(*grid_[propagationIndexes_.back()], 1ULL << propagationNumbers_.back());
+            propagationIndexes_.pop_back();
+            propagationNumbers_.pop_back();
+        }
+    }
+
+    bool LatinSquare::filter() noexcept {
+        uint_fast8_t line;
+
+        while (propagationRows_ || propagationColumns_) {
+            if (propagationRows_) {
+                line = std::countr_zero(propagationRows_);
+                propagationRows_ &= propagationRows_ - 1;
+
+                if (!filter(line * size_, 1, matchingRows_)) {
+                    return false;
+                }
+            } else {
+                line = std::countr_zero(propagationColumns_);
+                propagationColumns_ &= propagationColumns_ - 1;
+
+                if (!filter(line, size_, matchingColumns_)) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool LatinSquare::filter(
+        const uint_fast16_t first, const uint_fast16_t step, std::vector<uint_fast8_t>& matches) noexcept {
+        uint_fast8_t cells = 0;
+        uint_fast16_t index = first;
+
+        for (uint_fast8_t counter = 0; counter < size_; ++counter) {
+            if (grid_[index]->notFilled()) {
+                matchingCells_[cells] = index;
+                matchingDomains_[cells] = grid_[index]->positiveEntropy();
+                ++cells;
+            }
+
+            index += step;
+        }
+
+        if (!cells) {
+            return true;
+        }
+
+        // The matching found last time for the line is kept where it is still possible, only the cells that lost
+        // their numbers are augmented again.
+        std::fill(matchingNumberCells_.begin(), matchingNumberCells_.end(), EMPTY);
+        uint_fast64_t visited;
+        uint_fast8_t number;
+
+        for (uint_fast8_t cell = 0; cell < cells; ++cell) {
+            number = matches[matchingCells_[cell]];
+
+            if (number != EMPTY && ((matchingDomains_[cell] >> number) & 1) && matchingNumberCells_[number] == EMPTY) {
+                matchingNumberCells_[number] = cell;
+                matchingCellNumbers_[cell] = number;
+            } else {
+                matchingCellNumbers_[cell] = EMPTY;
+            }
+        }
+
+        for (uint_fast8_t cell = 0; cell < cells; ++cell) {
+            visited = 0;
+
+            if (matchingCellNumbers_[cell] == EMPTY && !augment(cell, visited)) {
+                return false;
+            }
+        }
+
+        for (uint_fast8_t cell = 0; cell < cells; ++cell) {
+            matches[matchingCells_[cell]] = matchingCellNumbers_[cell];
+        }
+        // Number a reaches number b when a cell matched with b can take a instead, numbers reachable from a free
+        // number or lying on a cycle with the matched number of a cell can be swapped into a maximum matching.
+        std::fill(matchingReach_.begin(), matchingReach_.end(), 0);
+        uint_fast64_t free = size_ < MAX_SIZE ? (1ULL << size_) - 1 : 0xFFFFFFFFFFFFFFFF;
+        uint_fast64_t numbers, matchedBit;
+
+        for (uint_fast8_t cell = 0; cell < cells; ++cell) {
+            matchedBit = 1ULL << matchingCellNumbers_[cell];
+            free &= ~matchedBit;
+            numbers = matchingDomains_[cell] & ~matchedBit;
+
+            while (numbers) {
+                matchingReach_[std::countr_zero(numbers)] |= matchedBit;
+                numbers &= numbers - 1;
+            }
+        }
+
+        for (uint_fast8_t middle = 0; middle < size_; ++middle) {
+            for (auto& reach : matchingReach_) {
+                if ((reach >> middle) & 1) {
+                    reach |= matchingReach_[middle];
+                }
+            }
+        }
+
+        uint_fast64_t freeReach = free;
+
+        for (numbers = free; numbers; numbers &= numbers - 1) {
+            freeReach |= matchingReach_[std::countr_zero(numbers)];
+        }
+
+        for (uint_fast8_t cell = 0; cell < cells; ++cell) {
+            number = matchingCellNumbers_[cell];
+            numbers = matchingDomains_[cell] & ~((1ULL << number) | freeReach | matchingReach_[number]);
+
+            while (numbers) {
+                number = std::countr_zero(numbers);
+                numbers &= numbers - 1;
+                grid_[matchingCells_[cell]]->remove(number);
+                removePositions(*grid_[matchingCells_[cell]], 1ULL << number);
+                propagationIndexes_.emplace_back(matchingCells_[cell]);
+                propagationNumbers_.emplace_back(number);
+
+                // The line itself stays consistent, only the crossing line of the cell has to be filtered again.
+                if (step == 1) {
+                    propagationColumns_ |= 1ULL << grid_[matchingCells_[cell]]->rawColumn();
+                } else {
+                    propagationRows_ |= 1ULL << grid_[matchingCells_[cell]]->rawRow();
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool LatinSquare::augment(const uint_fast8_t cell, uint_fast64_t& visited) noexcept {
+        uint_fast64_t numbers = matchingDomains_[cell];
+        uint_fast8_t number;
+
+        while (numbers) {
+            number = std::countr_zero(numbers);
+            numbers &= numbers - 1;
+
+            if ((visited >> number) & 1) {
+                continue;
+            }
+
+            visited |= 1ULL << number;
+
+            if (matchingNumberCells_[number] == EMPTY || augment(matchingNumberCells_[number], visited)) {
+                matchingNumberCells_[number] = cell;
+                matchingCellNumbers_[cell] = number;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     Region& LatinSquare::minEntropyRegion(const uint_fast8_t index) noexcept {
         if (index < DEFAULT_REGION_INDEX) {
             return regions_[index];
@@ -367,6 +900,103 @@ namespace LatinSquare {
         return regions_[0];
     }
 
+    // Every cell chosen later uses one row, one column and one number that are still available.
+    uint_fast8_t LatinSquare::regionsBound() const noexcept {
+        std::array<uint_fast8_t, 3> counters = {0, 0, 0};
+
+        for (const auto& region : regions_) {
+            counters[region.index() / size_] += !region.notEnabled() && region.entropy();
+        }
+
+        return std::min({counters[0], counters[1], counters[2]});
+    }
+
+    uint_fast64_t LatinSquare::lastRegionsCount() noexcept {
+        return setLastRegions() ? lastRegionsCount(0, 0, 0) : 0;
+    }
+
+    uint_fast64_t LatinSquare::lastRegionsTransversals(std::string& transversal, std::string& transversals) noexcept {
+        return setLastRegions() ? lastRegionsTransversals(0, 0, 0, transversal, transversals) : 0;
+    }
+
+    bool LatinSquare::setLastRegions() noexcept {
+        lastRegionsCells_.clear();
+        lastRegionsOffsets_.clear();
+        lastRegionsRows_.clear();
+        uint_fast16_t index = 0;
+
+        for (uint_fast8_t row = 0; row < size_; ++row) {
+            if (regions_[row].notEnabled()) {
+                index += size_;
+                continue;
+            }
+
+            if (!regions_[row].entropy()) {
+                return false;
+            }
+
+            lastRegionsOffsets_.emplace_back(lastRegionsCells_.size());
+            lastRegionsRows_.emplace_back(row);
+
+            for (uint_fast8_t column = 0; column < size_; ++column) {
+                if (grid_[index]->enabled()) {
+                    lastRegionsCells_.emplace_back(column);
+                    lastRegionsCells_.emplace_back(grid_[index]->number());
+                }
+
+                ++index;
+            }
+        }
+
+        lastRegionsOffsets_.emplace_back(lastRegionsCells_.size());
+        return true;
+    }
+
+    uint_fast64_t LatinSquare::lastRegionsCount(
+        const uint_fast8_t region, const uint_fast64_t columns, const uint_fast64_t numbers) const noexcept {
+        if (region + 1U == lastRegionsOffsets_.size()) {
+            return 1;
+        }
+
+        uint_fast64_t counter = 0;
+        uint_fast64_t column, number;
+
+        for (uint_fast16_t index = lastRegionsOffsets_[region]; index < lastRegionsOffsets_[region + 1]; index += 2) {
+            column = 1ULL << lastRegionsCells_[index];
+            number = 1ULL << lastRegionsCells_[index + 1];
+
+            if (!(columns & column) && !(numbers & number)) {
+                counter += lastRegionsCount(region + 1, columns | column, numbers | number);
+            }
+        }
+
+        return counter;
+    }
+
+    uint_fast64_t LatinSquare::lastRegionsTransversals(const uint_fast8_t region, const uint_fast64_t columns,
+        const uint_fast64_t numbers, std::string& transversal, std::string& transversals) const noexcept {
+        if (region + 1U == lastRegionsOffsets_.size()) {
+            transversals.append(transversal);
+            return 1;
+        }
+
+        uint_fast64_t counter = 0;
+        uint_fast64_t column, number;
+
+        for (uint_fast16_t index = lastRegionsOffsets_[region]; index < lastRegionsOffsets_[region + 1]; index += 2) {
+            column = 1ULL << lastRegionsCells_[index];
+            number = 1ULL << lastRegionsCells_[index + 1];
+
+            if (!(columns & column) && !(numbers & number)) {
+                transversal[lastRegionsRows_[region]] = static_cast<char>(lastRegionsCells_[index]);
+                counter += lastRegionsTransversals(
+                    region + 1, columns | column, numbers | number, transversal, transversals);
+            }
+        }
+
+        return counter;
+    }
+
     Region& LatinSquare::randomMinEntropyRegion(const uint_fast8_t index) noexcept {
         if (index < DEFAULT_REGION_INDEX) {
             return regions_[index];
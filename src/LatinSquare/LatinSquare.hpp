@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <cpp/random.hpp>
@@ -24,9 +27,26 @@ namespace LatinSquare {
                 : size_(other.size_), gridSize_(other.gridSize_), entropyGridSize_(other.entropyGridSize_),
                   doubleSize_(other.doubleSize_), maxUpdateSize_(other.maxUpdateSize_),
                   regionsSize_(other.regionsSize_), maxDisableAndDecreaseSize_(other.maxDisableAndDecreaseSize_),
-                  regions_(other.regions_), splitmix64_(other.splitmix64_), minCell_(other.minCell_),
-                  minRegion_(other.minRegion_), minEntropy_(other.minEntropy_), notFilled_(other.notFilled_),
-                  updateIndexes_(other.updateIndexes_), disableAndDecreaseIndexes_(other.disableAndDecreaseIndexes_) {
+                  type_(other.type_), regions_(other.regions_), splitmix64_(other.splitmix64_),
+                  minCell_(other.minCell_), minRegion_(other.minRegion_), minEntropy_(other.minEntropy_),
+                  notFilled_(other.notFilled_), updateIndexes_(other.updateIndexes_),
+                  disableAndDecreaseIndexes_(other.disableAndDecreaseIndexes_),
+                  rowsNotFilled_(other.rowsNotFilled_), columnsNotFilled_(other.columnsNotFilled_),
+                  notFilledRows_(other.notFilledRows_), notFilledColumns_(other.notFilledColumns_),
+                  lastLinesMasks_(other.lastLinesMasks_), lastLinesSides_(other.lastLinesSides_),
+                  lastLinesEdges_(other.lastLinesEdges_), lastLinesNumberEdges_(other.lastLinesNumberEdges_),
+                  lastLinesOrientations_(other.lastLinesOrientations_),
+                  lastLinesComponent_(other.lastLinesComponent_), lastLinesStack_(other.lastLinesStack_),
+                  propagation_(other.propagation_), propagationIndexes_(other.propagationIndexes_),
+                  propagationNumbers_(other.propagationNumbers_), propagationMarks_(other.propagationMarks_),
+                  propagationRows_(other.propagationRows_), propagationColumns_(other.propagationColumns_),
+                  matchingCells_(other.matchingCells_), matchingDomains_(other.matchingDomains_),
+                  matchingCellNumbers_(other.matchingCellNumbers_), matchingNumberCells_(other.matchingNumberCells_),
+                  matchingReach_(other.matchingReach_), matchingRows_(other.matchingRows_),
+                  matchingColumns_(other.matchingColumns_), symbolRegions_(other.symbolRegions_),
+                  positions_(other.positions_), lineNumbers_(other.lineNumbers_),
+                  singlePositions_(other.singlePositions_), singleLines_(other.singleLines_),
+                  minNumber_(other.minNumber_), noEntropyCell_(other.noEntropyCell_) {
                 grid_.reserve(other.grid_.size());
 
                 for (const auto& cell : other.grid_) {
@@ -59,6 +79,7 @@ namespace LatinSquare {
                     maxUpdateSize_ = other.maxUpdateSize_;
                     regionsSize_ = other.regionsSize_;
                     maxDisableAndDecreaseSize_ = other.maxDisableAndDecreaseSize_;
+                    type_ = other.type_;
                     regions_ = other.regions_;
                     splitmix64_ = other.splitmix64_;
                     minCell_ = other.minCell_;
@@ -67,6 +88,37 @@ namespace LatinSquare {
                     notFilled_ = other.notFilled_;
                     updateIndexes_ = other.updateIndexes_;
                     disableAndDecreaseIndexes_ = other.disableAndDecreaseIndexes_;
+                    rowsNotFilled_ = other.rowsNotFilled_;
+                    columnsNotFilled_ = other.columnsNotFilled_;
+                    notFilledRows_ = other.notFilledRows_;
+                    notFilledColumns_ = other.notFilledColumns_;
+                    lastLinesMasks_ = other.lastLinesMasks_;
+                    lastLinesSides_ = other.lastLinesSides_;
+                    lastLinesEdges_ = other.lastLinesEdges_;
+                    lastLinesNumberEdges_ = other.lastLinesNumberEdges_;
+                    lastLinesOrientations_ = other.lastLinesOrientations_;
+                    lastLinesComponent_ = other.lastLinesComponent_;
+                    lastLinesStack_ = other.lastLinesStack_;
+                    propagation_ = other.propagation_;
+                    propagationIndexes_ = other.propagationIndexes_;
+                    propagationNumbers_ = other.propagationNumbers_;
+                    propagationMarks_ = other.propagationMarks_;
+                    propagationRows_ = other.propagationRows_;
+                    propagationColumns_ = other.propagationColumns_;
+                    matchingCells_ = other.matchingCells_;
+                    matchingDomains_ = other.matchingDomains_;
+                    matchingCellNumbers_ = other.matchingCellNumbers_;
+                    matchingNumberCells_ = other.matchingNumberCells_;
+                    matchingReach_ = other.matchingReach_;
+                    matchingRows_ = other.matchingRows_;
+                    matchingColumns_ = other.matchingColumns_;
+                    symbolRegions_ = other.symbolRegions_;
+                    positions_ = other.positions_;
+                    lineNumbers_ = other.lineNumbers_;
+                    singlePositions_ = other.singlePositions_;
+                    singleLines_ = other.singleLines_;
+                    minNumber_ = other.minNumber_;
+                    noEntropyCell_ = other.noEntropyCell_;
                     grid_.clear();
                     grid_.reserve(other.grid_.size());
 
@@ -108,44 +160,83 @@ namespace LatinSquare {
                 return notFilled_;
             }
 
+            [[nodiscard]] inline constexpr uint_fast8_t minNumber() const noexcept {
+                return minNumber_;
+            }
+
+            [[nodiscard]] inline constexpr bool lastLines() const noexcept {
+                return (notFilledRows_ < 3 || notFilledColumns_ < 3) && type_ != Type::ReducedDiagonal;
+            }
+
             inline void fillAndClear(Cell& cell, const uint_fast8_t number) noexcept {
+                placePositions(cell, number);
                 cell.fillAndClear(number);
                 --notFilled_;
+                notFilledRows_ -= !--rowsNotFilled_[cell.rawRow()];
+                notFilledColumns_ -= !--columnsNotFilled_[cell.rawColumn()];
             }
 
             inline void set(const uint_fast16_t index, const EntropyData& entropyData) noexcept {
+                const auto numbers = grid_[index]->positiveEntropy();
+                removePositions(*grid_[index], numbers & ~entropyData.positiveEntropy());
+                restorePositions(*grid_[index], entropyData.positiveEntropy() & ~numbers);
                 grid_[index]->set(entropyData);
             }
 
             inline void clearAndRemove(const uint_fast16_t index, const EntropyData& entropyData) noexcept {
+                const auto number = grid_[index]->number();
                 grid_[index]->clearAndRemove(entropyData);
+                unplacePositions(*grid_[index], number);
                 ++notFilled_;
+                notFilledRows_ += !rowsNotFilled_[grid_[index]->rawRow()]++;
+                notFilledColumns_ += !columnsNotFilled_[grid_[index]->rawColumn()]++;
+
+                if (propagation_) {
+                    queue(*grid_[index]);
+                }
             }
 
             inline void clear(const uint_fast16_t index, const EntropyData& entropyData) noexcept {
+                const auto number = grid_[index]->number();
                 grid_[index]->clear(entropyData);
+                unplacePositions(*grid_[index], number);
                 ++notFilled_;
+                notFilledRows_ += !rowsNotFilled_[grid_[index]->rawRow()]++;
+                notFilledColumns_ += !columnsNotFilled_[grid_[index]->rawColumn()]++;
             }
 
-            inline constexpr void restore(
-                const std::vector<uint_fast16_t>& indexes, const uint_fast8_t number) noexcept {
+            inline void restore(const std::vector<uint_fast16_t>& indexes, const uint_fast8_t number) noexcept {
                 for (const auto index : indexes) {
                     grid_[index]->restore(number);
+                    restorePositions(*grid_[index], 1ULL << number);
                 }
             }
 
+            inline constexpr void propagation(const bool propagation) noexcept {
+                propagation_ = propagation;
+            }
+
+            void symbolRegions(const bool symbolRegions) noexcept;
             void set(const Type type) noexcept;
             void set(const std::vector<uint_fast8_t>& numbers) noexcept;
             void setRegions() noexcept;
             void resetCellsAndRegions() noexcept;
 
             [[nodiscard]] Cell& minEntropyCell(const uint_fast16_t index) noexcept;
+            [[nodiscard]] Cell& minEntropyCellOrLine(const uint_fast16_t index) noexcept;
             [[nodiscard]] Cell& lastNotFilledCell() noexcept;
             [[nodiscard]] Cell& randomMinEntropyCell(const uint_fast16_t index) noexcept;
             const std::vector<uint_fast16_t>& update(Cell& cell, const uint_fast8_t number) noexcept;
+            [[nodiscard]] uint_fast64_t lastLinesCount() noexcept;
+            [[nodiscard]] bool completable() noexcept;
+            [[nodiscard]] bool propagate() noexcept;
+            void unpropagate() noexcept;
 
             [[nodiscard]] Region& minEntropyRegion(const uint_fast8_t index) noexcept;
             [[nodiscard]] Region& lastNotChosenRegion() noexcept;
+            [[nodiscard]] uint_fast8_t regionsBound() const noexcept;
+            [[nodiscard]] uint_fast64_t lastRegionsCount() noexcept;
+            uint_fast64_t lastRegionsTransversals(std::string& transversal, std::string& transversals) noexcept;
             [[nodiscard]] Region& randomMinEntropyRegion(const uint_fast8_t index) noexcept;
             void disable(const uint_fast16_t index) noexcept;
             [[nodiscard]] const std::vector<uint_fast16_t>& disableAndDecrease(const uint_fast16_t index) noexcept;
@@ -157,6 +248,105 @@ namespace LatinSquare {
             void reset() noexcept;
             void reset(const std::vector<uint_fast8_t>& numbers) noexcept;
             void resetRegions() noexcept;
+            [[nodiscard]] bool setLastRegions() noexcept;
+            [[nodiscard]] uint_fast64_t lastRegionsCount(
+                const uint_fast8_t region, const uint_fast64_t columns, const uint_fast64_t numbers) const noexcept;
+            uint_fast64_t lastRegionsTransversals(const uint_fast8_t region, const uint_fast64_t columns,
+                const uint_fast64_t numbers, std::string& transversal, std::string& transversals) const noexcept;
+            void setNotFilledLines() noexcept;
+            void setPositions() noexcept;
+
+            inline void setSinglePosition(const uint_fast8_t line, const uint_fast8_t number) noexcept {
+                if (!symbolRegions_) {
+                    return;
+                }
+
+                const auto positions = positions_[line * size_ + number];
+                const uint_fast8_t side = line >= size_, bit = line - side * size_;
+                singlePositions_[line] &= ~(1ULL << number);
+                singlePositions_[line] |= static_cast<uint_fast64_t>(
+                    !(positions & (positions - 1)) && !(lineNumbers_[line] & (1ULL << number))) << number;
+                singleLines_[side] &= ~(1ULL << bit);
+                singleLines_[side] |= static_cast<uint_fast64_t>(singlePositions_[line] != 0) << bit;
+            }
+
+            inline void removePosition(const uint_fast8_t line, const uint_fast8_t number,
+                                       const uint_fast8_t position) noexcept {
+                if (!symbolRegions_) {
+                    return;
+                }
+
+                positions_[line * size_ + number] &= ~(1ULL << position);
+                setSinglePosition(line, number);
+            }
+
+            inline void removePositions(const Cell& cell, uint_fast64_t numbers) noexcept {
+                if (!symbolRegions_) {
+                    return;
+                }
+
+                const uint_fast8_t row = cell.rawRow(), column = size_ + cell.rawColumn();
+                uint_fast8_t number;
+
+                for (; numbers; numbers &= numbers - 1) {
+                    number = std::countr_zero(numbers);
+                    positions_[row * size_ + number] &= ~(1ULL << cell.rawColumn());
+                    positions_[column * size_ + number] &= ~(1ULL << cell.rawRow());
+                    setSinglePosition(row, number);
+                    setSinglePosition(column, number);
+                }
+            }
+
+            inline void placePositions(const Cell& cell, const uint_fast8_t number) noexcept {
+                if (!symbolRegions_) {
+                    return;
+                }
+
+                lineNumbers_[cell.rawRow()] |= 1ULL << number;
+                lineNumbers_[size_ + cell.rawColumn()] |= 1ULL << number;
+                removePositions(cell, cell.positiveEntropy());
+            }
+
+            inline void unplacePositions(const Cell& cell, const uint_fast8_t number) noexcept {
+                if (!symbolRegions_) {
+                    return;
+                }
+
+                lineNumbers_[cell.rawRow()] &= ~(1ULL << number);
+                lineNumbers_[size_ + cell.rawColumn()] &= ~(1ULL << number);
+                restorePositions(cell, cell.positiveEntropy());
+                setSinglePosition(cell.rawRow(), number);
+                setSinglePosition(size_ + cell.rawColumn(), number);
+            }
+
+            inline void restorePositions(const Cell& cell, uint_fast64_t numbers) noexcept {
+                if (!symbolRegions_) {
+                    return;
+                }
+
+                const uint_fast8_t row = cell.rawRow(), column = size_ + cell.rawColumn();
+                uint_fast8_t number;
+
+                for (; numbers; numbers &= numbers - 1) {
+                    number = std::countr_zero(numbers);
+                    positions_[row * size_ + number] |= 1ULL << cell.rawColumn();
+                    positions_[column * size_ + number] |= 1ULL << cell.rawRow();
+                    setSinglePosition(row, number);
+                    setSinglePosition(column, number);
+                }
+            }
+
+            [[nodiscard]] bool lastLinesOrientation(
+                const uint_fast8_t index, const uint_fast8_t orientation, std::array<uint_fast64_t, 2> used) noexcept;
+            inline constexpr void queue(const Cell& cell) noexcept {
+                propagationRows_ |= 1ULL << cell.rawRow();
+                propagationColumns_ |= 1ULL << cell.rawColumn();
+            }
+
+            [[nodiscard]] bool filter() noexcept;
+            [[nodiscard]] bool filter(
+                const uint_fast16_t first, const uint_fast16_t step, std::vector<uint_fast8_t>& matches) noexcept;
+            [[nodiscard]] bool augment(const uint_fast8_t cell, uint_fast64_t& visited) noexcept;
 
             uint_fast8_t size_;
             uint_fast16_t gridSize_;
@@ -165,6 +355,7 @@ namespace LatinSquare {
             uint_fast8_t maxUpdateSize_;
             uint_fast8_t regionsSize_;
             uint_fast8_t maxDisableAndDecreaseSize_;
+            Type type_;
             std::vector<std::shared_ptr<Cell>> grid_;
             std::vector<std::shared_ptr<Cell>> entropyGrid_;
             std::vector<Region> regions_;
@@ -176,5 +367,39 @@ namespace LatinSquare {
             std::vector<uint_fast16_t> updateIndexes_;
             std::vector<std::vector<std::shared_ptr<Cell>>> numberCells_;
             std::vector<uint_fast16_t> disableAndDecreaseIndexes_;
+            std::vector<uint_fast8_t> lastRegionsCells_;
+            std::vector<uint_fast16_t> lastRegionsOffsets_;
+            std::vector<uint_fast8_t> lastRegionsRows_;
+            std::vector<uint_fast8_t> rowsNotFilled_;
+            std::vector<uint_fast8_t> columnsNotFilled_;
+            uint_fast8_t notFilledRows_;
+            uint_fast8_t notFilledColumns_;
+            std::vector<uint_fast64_t> lastLinesMasks_;
+            std::vector<uint_fast8_t> lastLinesSides_;
+            std::vector<uint_fast8_t> lastLinesEdges_;
+            std::vector<uint_fast8_t> lastLinesNumberEdges_;
+            std::vector<uint_fast8_t> lastLinesOrientations_;
+            std::vector<uint_fast8_t> lastLinesComponent_;
+            std::vector<uint_fast8_t> lastLinesStack_;
+            bool propagation_;
+            std::vector<uint_fast16_t> propagationIndexes_;
+            std::vector<uint_fast8_t> propagationNumbers_;
+            std::vector<size_t> propagationMarks_;
+            uint_fast64_t propagationRows_;
+            uint_fast64_t propagationColumns_;
+            std::vector<uint_fast16_t> matchingCells_;
+            std::vector<uint_fast64_t> matchingDomains_;
+            std::vector<uint_fast8_t> matchingCellNumbers_;
+            std::vector<uint_fast8_t> matchingNumberCells_;
+            std::vector<uint_fast64_t> matchingReach_;
+            std::vector<uint_fast8_t> matchingRows_;
+            std::vector<uint_fast8_t> matchingColumns_;
+            bool symbolRegions_;
+            std::vector<uint_fast64_t> positions_;
+            std::vector<uint_fast64_t> lineNumbers_;
+            std::vector<uint_fast64_t> singlePositions_;
+            std::array<uint_fast64_t, 2> singleLines_;
+            uint_fast8_t minNumber_;
+            std::shared_ptr<Cell> noEntropyCell_;
     };
 }
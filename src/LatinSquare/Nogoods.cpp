@@ -0,0 +1,85 @@
+#include "Nogoods.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "Constants.hpp"
+
+namespace LatinSquare {
+    void Nogoods::reset(const uint_fast16_t gridSize) noexcept {
+        nogoods_.clear();
+        watches_.assign(gridSize, std::vector<uint_fast16_t>());
+        literals_.reserve(MAX_NOGOOD_LENGTH);
+        next_ = 0;
+    }
+
+    void Nogoods::insert(
+        const std::vector<uint_fast64_t>& cells, const uint_fast16_t latest, const LatinSquare& latinSquare) noexcept {
+        literals_.clear();
+
+        for (size_t word = 0; word < cells.size(); ++word) {
+            for (auto bits = cells[word]; bits; bits &= bits - 1) {
+                if (literals_.size() == MAX_NOGOOD_LENGTH) {
+                    return;
+                }
+
+                const uint_fast16_t index = word * 64 + std::countr_zero(bits);
+                literals_.emplace_back(literal(index, latinSquare.grid()[index]->number()));
+
+                if (index == latest) {
+                    std::swap(literals_.front(), literals_.back());
+                }
+            }
+        }
+
+        if (nogoods_.size() < MAX_NOGOODS) {
+            nogoods_.emplace_back();
+        } else {
+            // The oldest nogood gives way, it was learned in a part of the search that is probably left behind.
+            auto& watch = watches_[index(nogoods_[next_].front())];
+            *std::find(watch.begin(), watch.end(), next_) = watch.back();
+            watch.pop_back();
+        }
+
+        // Only the first literal is watched, the latest number of the set is taken back right after it is learned.
+        nogoods_[next_] = literals_;
+        watches_[index(literals_.front())].emplace_back(next_);
+        next_ = (next_ + 1) % MAX_NOGOODS;
+    }
+
+    bool Nogoods::find(const Cell& cell, const LatinSquare& latinSquare, std::vector<uint_fast64_t>& cells) noexcept {
+        const auto& grid = latinSquare.grid();
+        auto& watch = watches_[cell.index()];
+        const auto assigned = [&grid](const uint_fast32_t literal) {
+            return grid[index(literal)]->filled() && grid[index(literal)]->number() == number(literal);
+        };
+
+        for (size_t position = 0; position < watch.size();) {
+            auto& nogood = nogoods_[watch[position]];
+
+            if (number(nogood.front()) != cell.number()) {
+                ++position;
+                continue;
+            }
+
+            const auto literal = std::find_if_not(nogood.begin() + 1, nogood.end(), assigned);
+
+            if (literal == nogood.end()) {
+                std::fill(cells.begin(), cells.end(), 0);
+
+                for (const auto violated : nogood) {
+                    cells[index(violated) >> 6] |= 1ULL << (index(violated) & 63);
+                }
+
+                return true;
+            }
+
+            std::swap(nogood.front(), *literal);
+            watches_[index(nogood.front())].emplace_back(watch[position]);
+            watch[position] = watch.back();
+            watch.pop_back();
+        }
+
+        return false;
+    }
+}
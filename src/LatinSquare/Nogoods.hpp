@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Cell.hpp"
+#include "LatinSquare.hpp"
+
+namespace LatinSquare {
+    class Nogoods {
+        public:
+            void reset(const uint_fast16_t gridSize) noexcept;
+            void insert(const std::vector<uint_fast64_t>& cells, const uint_fast16_t latest,
+                const LatinSquare& latinSquare) noexcept;
+
+            [[nodiscard]] bool find(
+                const Cell& cell, const LatinSquare& latinSquare, std::vector<uint_fast64_t>& cells) noexcept;
+
+        private:
+            [[nodiscard]] inline static constexpr uint_fast32_t literal(
+                const uint_fast16_t index, const uint_fast8_t number) noexcept {
+                return static_cast<uint_fast32_t>(index) << 8 | number;
+            }
+
+            [[nodiscard]] inline static constexpr uint_fast16_t index(const uint_fast32_t literal) noexcept {
+                return literal >> 8;
+            }
+
+            [[nodiscard]] inline static constexpr uint_fast8_t number(const uint_fast32_t literal) noexcept {
+                return literal & 0xFF;
+            }
+
+            std::vector<std::vector<uint_fast32_t>> nogoods_;
+            std::vector<std::vector<uint_fast16_t>> watches_;
+            std::vector<uint_fast32_t> literals_;
+            size_t next_ = 0;
+    };
+}
@@ -0,0 +1,172 @@
+#include "Parser.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Constants.hpp"
+
+namespace LatinSquare {
+    namespace {
+        [[nodiscard]] inline constexpr bool isSpace(const char character) noexcept {
+            return character == ' ' || character == '\t' || character == '\r';
+        }
+
+        [[nodiscard]] inline constexpr bool isBlank(const std::string_view line) noexcept {
+            return std::all_of(line.begin(), line.end(), isSpace);
+        }
+    }
+
+    Parser::Parser(const std::string& filename) noexcept
+        : file_(filename == STANDARD_INPUT ? STDIN_FILENO : ::open(filename.c_str(), O_RDONLY)),
+          ownsFile_(filename != STANDARD_INPUT), endOfFile_(false), buffer_(PARSER_BUFFER_SIZE), begin_(0), end_(0),
+          size_(0), valid_(false), block_(0) {
+        numbers_.reserve(MAX_SIZE * MAX_SIZE);
+    }
+
+    Parser::~Parser() noexcept {
+        if (ownsFile_ && file_ >= 0) {
+            ::close(file_);
+        }
+    }
+
+    bool Parser::next() noexcept {
+        std::string_view line;
+        size_ = 0;
+        numbers_.clear();
+        valid_ = false;
+
+        if (!firstLine(line)) {
+            return false;
+        }
+
+        // The whole block up to the next empty line is consumed even if it is malformed, so that the next one can
+        // still be read. Only the end of input returns false, a malformed block is reported by valid().
+        auto valid = true;
+        uint_fast8_t counter = 0;
+        uint_fast16_t linesCounter = 0;
+
+        do {
+            if (valid && parse(line, counter)) {
+                if (size_ == 0) {
+                    size_ = counter;
+                }
+
+                valid = counter == size_ && ++linesCounter <= size_;
+            } else {
+                valid = false;
+            }
+        } while (this->line(line) && !isBlank(line));
+
+        valid_ = valid && size_ > 0 && linesCounter == size_ && isValid();
+        return true;
+    }
+
+    bool Parser::nextTriangular() noexcept {
+        std::string_view line;
+        size_ = 0;
+        numbers_.clear();
+        valid_ = false;
+
+        if (!firstLine(line)) {
+            return false;
+        }
+
+        auto valid = true;
+        uint_fast8_t counter = 0;
+
+        do {
+            valid = valid && size_ < MAX_SIZE && parse(line, counter) && counter == ++size_;
+        } while (this->line(line) && !isBlank(line));
+
+        valid_ = valid && isValid();
+        return true;
+    }
+
+    bool Parser::line(std::string_view& line) noexcept {
+        while (file_ >= 0) {
+            const auto first = buffer_.data() + begin_, last = buffer_.data() + end_;
+            const auto newline = std::find(first, last, '\n');
+
+            if (newline != last) {
+                line = std::string_view(first, newline - first);
+                begin_ += newline - first + 1;
+                return true;
+            }
+
+            if (endOfFile_) {
+                line = std::string_view(first, last - first);
+                begin_ = end_;
+                return first != last;
+            }
+
+            if (begin_ > 0) {
+                std::memmove(buffer_.data(), first, end_ - begin_);
+                end_ -= begin_;
+                begin_ = 0;
+            }
+
+            if (end_ == buffer_.size()) {
+                buffer_.resize(2 * buffer_.size());
+            }
+
+            const auto result = ::read(file_, buffer_.data() + end_, buffer_.size() - end_);
+
+            if (result > 0) {
+                end_ += result;
+            } else if (result == 0 || errno != EINTR) {
+                endOfFile_ = true;
+            }
+        }
+
+        return false;
+    }
+
+    bool Parser::firstLine(std::string_view& line) noexcept {
+        do {
+            if (!this->line(line)) {
+                return false;
+            }
+        } while (isBlank(line));
+
+        ++block_;
+        return true;
+    }
+
+    bool Parser::parse(const std::string_view line, uint_fast8_t& counter) noexcept {
+        auto first = line.data();
+        const auto last = first + line.size();
+        counter = 0;
+
+        while (true) {
+            while (first != last && isSpace(*first)) {
+                ++first;
+            }
+
+            if (first == last) {
+                return true;
+            }
+
+            uint_fast32_t number;
+            const auto [pointer, error] = std::from_chars(first, last, number);
+
+            if (error != std::errc() || number > MAX_SIZE || counter == MAX_SIZE
+                || (pointer != last && !isSpace(*pointer))) {
+                return false;
+            }
+
+            numbers_.emplace_back(number ? number - 1 : EMPTY);
+            ++counter;
+            first = pointer;
+        }
+    }
+
+    bool Parser::isValid() const noexcept {
+        return std::all_of(numbers_.begin(), numbers_.end(),
+            [this](const uint_fast8_t number) { return number < size_ || number == EMPTY; });
+    }
+}
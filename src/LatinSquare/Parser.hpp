@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LatinSquare {
+    class Parser {
+        public:
+            explicit Parser(const std::string& filename) noexcept;
+            ~Parser() noexcept;
+
+            Parser(const Parser&) = delete;
+            Parser& operator=(const Parser&) = delete;
+
+            [[nodiscard]] inline constexpr bool isOpen() const noexcept {
+                return file_ >= 0;
+            }
+
+            [[nodiscard]] inline constexpr uint_fast8_t size() const noexcept {
+                return size_;
+            }
+
+            [[nodiscard]] inline const std::vector<uint_fast8_t>& numbers() const noexcept {
+                return numbers_;
+            }
+
+            [[nodiscard]] inline constexpr bool valid() const noexcept {
+                return valid_;
+            }
+
+            [[nodiscard]] inline constexpr size_t block() const noexcept {
+                return block_;
+            }
+
+            [[nodiscard]] bool next() noexcept;
+            [[nodiscard]] bool nextTriangular() noexcept;
+
+        private:
+            [[nodiscard]] bool line(std::string_view& line) noexcept;
+            [[nodiscard]] bool firstLine(std::string_view& line) noexcept;
+            [[nodiscard]] bool parse(const std::string_view line, uint_fast8_t& counter) noexcept;
+            [[nodiscard]] bool isValid() const noexcept;
+
+            int file_;
+            bool ownsFile_;
+            bool endOfFile_;
+            std::vector<char> buffer_;
+            size_t begin_;
+            size_t end_;
+            uint_fast8_t size_;
+            std::vector<uint_fast8_t> numbers_;
+            bool valid_;
+            size_t block_;
+    };
+}
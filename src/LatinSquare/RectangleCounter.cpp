@@ -0,0 +1,224 @@
+#include "RectangleCounter.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include <cpp/random.hpp>
+
+#include "Constants.hpp"
+
+namespace LatinSquare {
+    const boost::multiprecision::mpz_int RectangleCounter::count(
+        const uint_fast8_t size, const std::vector<uint_fast64_t>& columns, const uint_fast8_t rows) noexcept {
+        if (size != size_) {
+            set(size);
+        }
+
+        states_[rows] = columns;
+        return count(rows);
+    }
+
+    size_t RectangleCounter::KeyHash::operator()(const Key& key) const noexcept {
+        uint_fast64_t hash = 0;
+
+        for (const auto word : key) {
+            hash = (hash ^ word) * 0x9E3779B97F4A7C15;
+            hash ^= hash >> 29;
+        }
+
+        return hash;
+    }
+
+    // Counts are shared between sizes only through the key, so the table starts over for every new size.
+    void RectangleCounter::set(const uint_fast8_t size) noexcept {
+        size_ = size;
+        allNumbers_ = size_ < MAX_SIZE ? (1ULL << size_) - 1 : 0xFFFFFFFFFFFFFFFF;
+        states_.assign(size_ + 1, std::vector<uint_fast64_t>(size_));
+        totals_.assign(size_ + 1, 0);
+        counts_.clear();
+        colorings_.assign(2 * size_ + 1, std::vector<uint_fast64_t>(2 * size_));
+        signatures_.resize(2 * size_);
+        vertices_.resize(2 * size_);
+        cpp::splitmix64 splitmix64(size_);
+
+        for (auto& hash : hashes_) {
+            hash = splitmix64.next();
+        }
+    }
+
+    const boost::multiprecision::mpz_int RectangleCounter::count(const uint_fast8_t rows) noexcept {
+        if (rows + 1 >= size_) {
+            return 1;
+        }
+
+        // The last two rows split every cycle of the two remaining numbers of the columns in one of two ways.
+        if (rows + 2 == size_) {
+            return boost::multiprecision::mpz_int(1) << cycles(states_[rows]);
+        }
+
+        const auto key = canonical(states_[rows]);
+        const auto position = counts_.find(key);
+
+        if (position != counts_.end()) {
+            return position->second;
+        }
+
+        totals_[rows] = 0;
+        extend(rows, 0, 0);
+        counts_.emplace(key, totals_[rows]);
+        return totals_[rows];
+    }
+
+    void RectangleCounter::extend(
+        const uint_fast8_t rows, const uint_fast8_t column, const uint_fast64_t used) noexcept {
+        if (column == size_) {
+            totals_[rows] += count(rows + 1);
+            return;
+        }
+
+        for (auto numbers = allNumbers_ & ~states_[rows][column] & ~used; numbers; numbers &= numbers - 1) {
+            const auto number = numbers & (~numbers + 1);
+            states_[rows + 1][column] = states_[rows][column] | number;
+            extend(rows, column + 1, used | number);
+        }
+    }
+
+    uint_fast8_t RectangleCounter::cycles(const std::vector<uint_fast64_t>& columns) const noexcept {
+        uint_fast64_t visited = 0;
+        uint_fast8_t result = 0;
+
+        for (uint_fast8_t first = 0; first < size_; ++first) {
+            if (visited & (1ULL << first)) {
+                continue;
+            }
+
+            auto column = first;
+            auto number = std::countr_zero(allNumbers_ & ~columns[column]);
+            ++result;
+
+            do {
+                visited |= 1ULL << column;
+                uint_fast8_t next = 0;
+
+                while (next == column || (columns[next] & (1ULL << number))) {
+                    ++next;
+                }
+
+                column = next;
+                number = std::countr_zero(allNumbers_ & ~columns[column] & ~(1ULL << number));
+            } while (column != first);
+        }
+
+        return result;
+    }
+
+    // Columns and numbers are the two sides of a graph, a number is joined to the columns that already contain it.
+    // Colour refinement with individualisation orders both sides, and the smallest adjacency found over a bounded
+    // number of orders is the key. A key is always the state of some relabelling of the rectangle, so it is never
+    // shared by two rectangles with different counts, even when the bound stops the search before the true minimum.
+    RectangleCounter::Key RectangleCounter::canonical(const std::vector<uint_fast64_t>& columns) noexcept {
+        graph_ = &columns;
+        auto& colors = colorings_[0];
+        std::fill(colors.begin(), colors.begin() + size_, 0);
+        std::fill(colors.begin() + size_, colors.end(), 1);
+        minForm_.fill(0xFFFFFFFFFFFFFFFF);
+        leaves_ = 0;
+        search(0);
+        return minForm_;
+    }
+
+    void RectangleCounter::refine(std::vector<uint_fast64_t>& colors) noexcept {
+        const uint_fast8_t vertices = 2 * size_;
+        uint_fast8_t classes = 0;
+
+        while (true) {
+            for (uint_fast8_t column = 0; column < size_; ++column) {
+                uint_fast64_t signature = 0;
+
+                for (auto numbers = (*graph_)[column]; numbers; numbers &= numbers - 1) {
+                    signature += hashes_[colors[size_ + std::countr_zero(numbers)]];
+                }
+
+                signatures_[column] = signature;
+                signatures_[size_ + column] = 0;
+            }
+
+            for (uint_fast8_t column = 0; column < size_; ++column) {
+                for (auto numbers = (*graph_)[column]; numbers; numbers &= numbers - 1) {
+                    signatures_[size_ + std::countr_zero(numbers)] += hashes_[colors[column]];
+                }
+            }
+
+            for (uint_fast8_t vertex = 0; vertex < vertices; ++vertex) {
+                vertices_[vertex] = vertex;
+            }
+
+            std::sort(vertices_.begin(), vertices_.end(), [&colors, this](const uint_fast8_t a, const uint_fast8_t b) {
+                return colors[a] != colors[b] ? colors[a] < colors[b] : signatures_[a] < signatures_[b];
+            });
+
+            uint_fast8_t newClasses = 0;
+            uint_fast64_t color = colors[vertices_[0]], signature = signatures_[vertices_[0]];
+
+            for (const auto vertex : vertices_) {
+                newClasses += colors[vertex] != color || signatures_[vertex] != signature;
+                color = colors[vertex];
+                signature = signatures_[vertex];
+                colors[vertex] = newClasses;
+            }
+
+            if (++newClasses == classes || newClasses == vertices) {
+                return;
+            }
+
+            classes = newClasses;
+        }
+    }
+
+    void RectangleCounter::search(const uint_fast8_t depth) noexcept {
+        auto& colors = colorings_[depth];
+        refine(colors);
+        const uint_fast8_t vertices = 2 * size_;
+        uint_fast64_t target = vertices;
+
+        for (uint_fast8_t vertex = 0; vertex < vertices && target == vertices; ++vertex) {
+            for (uint_fast8_t other = vertex + 1; other < vertices; ++other) {
+                if (colors[other] == colors[vertex]) {
+                    target = std::min<uint_fast64_t>(target, colors[vertex]);
+                }
+            }
+        }
+
+        if (target == vertices) {
+            form_.fill(0);
+
+            for (uint_fast8_t column = 0; column < size_; ++column) {
+                uint_fast64_t mask = 0;
+
+                for (auto numbers = (*graph_)[column]; numbers; numbers &= numbers - 1) {
+                    mask |= 1ULL << (colors[size_ + std::countr_zero(numbers)] - size_);
+                }
+
+                form_[colors[column] >> 2] |= mask << ((colors[column] & 3) << 4);
+            }
+
+            minForm_ = std::min(minForm_, form_);
+            ++leaves_;
+            return;
+        }
+
+        auto& child = colorings_[depth + 1];
+
+        for (uint_fast8_t vertex = 0; vertex < vertices && leaves_ < MAX_CANONICAL_LEAVES; ++vertex) {
+            if (colors[vertex] != target) {
+                continue;
+            }
+
+            for (uint_fast8_t other = 0; other < vertices; ++other) {
+                child[other] = (colors[other] << 1) | (colors[other] == target && other != vertex);
+            }
+
+            search(depth + 1);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/multiprecision/gmp.hpp>
+
+namespace LatinSquare {
+    class RectangleCounter {
+        public:
+            [[nodiscard]] const boost::multiprecision::mpz_int count(
+                const uint_fast8_t size, const std::vector<uint_fast64_t>& columns, const uint_fast8_t rows) noexcept;
+
+        private:
+            using Key = std::array<uint_fast64_t, 4>;
+
+            struct KeyHash {
+                [[nodiscard]] size_t operator()(const Key& key) const noexcept;
+            };
+
+            void set(const uint_fast8_t size) noexcept;
+            [[nodiscard]] const boost::multiprecision::mpz_int count(const uint_fast8_t rows) noexcept;
+            void extend(const uint_fast8_t rows, const uint_fast8_t column, const uint_fast64_t used) noexcept;
+            [[nodiscard]] uint_fast8_t cycles(const std::vector<uint_fast64_t>& columns) const noexcept;
+
+            [[nodiscard]] Key canonical(const std::vector<uint_fast64_t>& columns) noexcept;
+            void refine(std::vector<uint_fast64_t>& colors) noexcept;
+            void search(const uint_fast8_t depth) noexcept;
+
+            uint_fast8_t size_ = 0;
+            uint_fast64_t allNumbers_;
+            std::vector<std::vector<uint_fast64_t>> states_;
+            std::vector<boost::multiprecision::mpz_int> totals_;
+            std::unordered_map<Key, boost::multiprecision::mpz_int, KeyHash> counts_;
+            std::array<uint_fast64_t, 64> hashes_;
+            const std::vector<uint_fast64_t>* graph_;
+            std::vector<std::vector<uint_fast64_t>> colorings_;
+            std::vector<uint_fast64_t> signatures_;
+            std::vector<uint_fast8_t> vertices_;
+            Key form_;
+            Key minForm_;
+            uint_fast16_t leaves_;
+    };
+}
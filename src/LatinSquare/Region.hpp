@@ -40,6 +40,10 @@ namespace LatinSquare {
                 notEnabled_ = false;
             }
 
+            inline void set(const uint_fast8_t position, const std::shared_ptr<Cell>& cell) noexcept {
+                cells_[position] = cell;
+            }
+
             inline constexpr void enable() noexcept {
                 notEnabled_ ^= true;
             }
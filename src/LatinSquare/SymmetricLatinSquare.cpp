@@ -1,5 +1,7 @@
 #include "SymmetricLatinSquare.hpp"
 
+#include <bit>
+
 namespace LatinSquare {
     SymmetricLatinSquare::SymmetricLatinSquare(const uint_fast8_t size, const Type type) noexcept
         : size_(size) {
@@ -207,7 +209,10 @@ namespace LatinSquare {
 
         for (uint_fast16_t index = 0; index < triangularGridSize_; ++index) {
             triangularGrid_[index]->reset();
+        }
 
+        // Every cell has to be reset before the given numbers are removed from their rows and columns.
+        for (uint_fast16_t index = 0; index < triangularGridSize_; ++index) {
             if (numbers[index] != DEFAULT_NUMBER) {
                 triangularGrid_[index]->fillAndClear(numbers[index]);
                 update(*triangularGrid_[index], numbers[index]);
@@ -427,6 +432,61 @@ namespace LatinSquare {
         return updateIndexes_;
     }
 
+    bool SymmetricLatinSquare::diagonalFeasible() noexcept {
+        uint_fast64_t forced = 0, notForced = 0;
+        diagonalMasks_.resize(size_);
+
+        for (uint_fast8_t index = 0; index < size_; ++index) {
+            const auto& cell = diagonalGrid_[index];
+            diagonalMasks_[index] = cell->filled() ? 1ULL << cell->number() : cell->positiveEntropy();
+
+            if (!diagonalMasks_[index]) {
+                return false;
+            }
+
+            if (std::has_single_bit(diagonalMasks_[index])) {
+                forced ^= diagonalMasks_[index];
+            } else {
+                notForced |= diagonalMasks_[index];
+            }
+        }
+
+        if (!(size_ & 1)) {
+            return !(forced & ~notForced);
+        }
+
+        diagonalOwners_.assign(size_, DEFAULT_NUMBER);
+
+        for (uint_fast8_t index = 0; index < size_; ++index) {
+            diagonalVisited_ = 0;
+
+            if (!diagonalAugment(index)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool SymmetricLatinSquare::diagonalAugment(const uint_fast8_t index) noexcept {
+        uint_fast64_t numbers = diagonalMasks_[index] & ~diagonalVisited_;
+        uint_fast8_t number;
+
+        while (numbers) {
+            number = std::countr_zero(numbers);
+            numbers &= numbers - 1;
+            diagonalVisited_ |= 1ULL << number;
+
+            if (diagonalOwners_[number] == DEFAULT_NUMBER || diagonalAugment(diagonalOwners_[number])) {
+                diagonalOwners_[number] = index;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     uint_fast8_t SymmetricLatinSquare::checkDiagonal() noexcept {
         for (const auto& cell : diagonalGrid_) {
             if (cell->notFilled() && !cell->positiveEntropy()) {
@@ -525,6 +585,59 @@ namespace LatinSquare {
         return regions_[0];
     }
 
+    uint_fast64_t SymmetricLatinSquare::lastRegionsCount() noexcept {
+        lastRegionsCells_.clear();
+        lastRegionsOffsets_.clear();
+        uint_fast16_t index = 0;
+
+        for (uint_fast8_t row = 0; row < size_; ++row) {
+            if (regions_[row].notEnabled()) {
+                index += size_;
+                continue;
+            }
+
+            if (!regions_[row].entropy()) {
+                return 0;
+            }
+
+            lastRegionsOffsets_.emplace_back(lastRegionsCells_.size());
+
+            for (uint_fast8_t column = 0; column < size_; ++column) {
+                if (grid_[index]->enabled()) {
+                    lastRegionsCells_.emplace_back(column);
+                    lastRegionsCells_.emplace_back(grid_[index]->number());
+                }
+
+                ++index;
+            }
+        }
+
+        lastRegionsOffsets_.emplace_back(lastRegionsCells_.size());
+
+        return lastRegionsCount(0, 0, 0);
+    }
+
+    uint_fast64_t SymmetricLatinSquare::lastRegionsCount(
+        const uint_fast8_t region, const uint_fast64_t columns, const uint_fast64_t numbers) const noexcept {
+        if (region + 1U == lastRegionsOffsets_.size()) {
+            return 1;
+        }
+
+        uint_fast64_t counter = 0;
+        uint_fast64_t column, number;
+
+        for (uint_fast16_t index = lastRegionsOffsets_[region]; index < lastRegionsOffsets_[region + 1]; index += 2) {
+            column = 1ULL << lastRegionsCells_[index];
+            number = 1ULL << lastRegionsCells_[index + 1];
+
+            if (!(columns & column) && !(numbers & number)) {
+                counter += lastRegionsCount(region + 1, columns | column, numbers | number);
+            }
+        }
+
+        return counter;
+    }
+
     Region& SymmetricLatinSquare::randomMinEntropyRegion(const uint_fast8_t index) noexcept {
         if (index < DEFAULT_REGION_INDEX) {
             return regions_[index];
@@ -188,12 +188,14 @@ namespace LatinSquare {
             [[nodiscard]] Cell& randomMinEntropyCell(const uint_fast16_t index) noexcept;
             const std::vector<uint_fast16_t>& update(Cell& cell, const uint_fast8_t number) noexcept;
             [[nodiscard]] uint_fast8_t checkDiagonal() noexcept;
+            [[nodiscard]] bool diagonalFeasible() noexcept;
             void fillGrid() noexcept;
             void fillDiagonal() noexcept;
             void clearDiagonal() noexcept;
 
             [[nodiscard]] Region& minEntropyRegion(const uint_fast8_t index) noexcept;
             [[nodiscard]] Region& lastNotChosenRegion() noexcept;
+            [[nodiscard]] uint_fast64_t lastRegionsCount() noexcept;
             [[nodiscard]] Region& randomMinEntropyRegion(const uint_fast8_t index) noexcept;
             void disable(const uint_fast16_t index) noexcept;
             [[nodiscard]] const std::vector<uint_fast16_t>& disableAndDecrease(const uint_fast16_t index) noexcept;
@@ -218,7 +220,10 @@ namespace LatinSquare {
             void reset() noexcept;
             void reset(const std::vector<uint_fast8_t>& numbers) noexcept;
             void resetRegions() noexcept;
+            [[nodiscard]] uint_fast64_t lastRegionsCount(
+                const uint_fast8_t region, const uint_fast64_t columns, const uint_fast64_t numbers) const noexcept;
             void resetNumberRegions() noexcept;
+            [[nodiscard]] bool diagonalAugment(const uint_fast8_t index) noexcept;
 
             uint_fast8_t size_;
             uint_fast16_t gridSize_;
@@ -247,6 +252,11 @@ namespace LatinSquare {
             std::vector<uint_fast16_t> fillDiagonalIndexes_;
             std::vector<std::vector<std::shared_ptr<Cell>>> numberCells_;
             std::vector<uint_fast16_t> disableAndDecreaseIndexes_;
+            std::vector<uint_fast64_t> diagonalMasks_;
+            std::vector<uint_fast8_t> diagonalOwners_;
+            uint_fast64_t diagonalVisited_;
+            std::vector<uint_fast8_t> lastRegionsCells_;
+            std::vector<uint_fast16_t> lastRegionsOffsets_;
             std::vector<Transversal::SymmetricCellUpdateData> cellUpdateData_;
             std::vector<Transversal::SymmetricCellUpdateData> otherCellsUpdateData_;
     };
@@ -1,13 +1,16 @@
 #include "Utils.hpp"
 
-#include <cmath>
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
-#include <sstream>
 
 #include <cpp/string.hpp>
 
+#include "Formatter.hpp"
+#include "Parser.hpp"
+
 namespace LatinSquare {
     Type getType(const std::string& type) noexcept {
         if (type == TYPE_NORMAL) {
@@ -23,263 +26,194 @@ namespace LatinSquare {
         }
     }
 
-    const std::pair<uint_fast8_t, std::vector<uint_fast8_t>> convert(const std::string& filename) noexcept {
-        std::ifstream file(filename);
+    const std::pair<uint_fast32_t, uint_fast32_t> getShard(const std::string& shard) noexcept {
+        const auto separator = shard.find('/');
 
-        if (!file) {
+        if (separator == std::string::npos || !cpp::is_number(shard.substr(0, separator))
+            || !cpp::is_number(shard.substr(separator + 1))) {
             return {};
         }
 
-        std::vector<uint_fast8_t> numbers;
-        std::string line, word;
-        uint_fast8_t number, size = 0, counter = 0, linesCounter = 0;
+        const uint_fast32_t index = std::strtoul(shard.c_str(), nullptr, 10);
+        const uint_fast32_t count = std::strtoul(shard.c_str() + separator + 1, nullptr, 10);
 
-        while (std::getline(file, line)) {
-            std::istringstream iss(line);
+        if (index >= count) {
+            return {};
+        }
 
-            while (iss >> word) {
-                number = std::strtoul(word.c_str(), nullptr, 10);
+        return {index, count};
+    }
 
-                if (number <= MAX_SIZE) {
-                    numbers.emplace_back(--number);
-                    ++counter;
-                } else {
-                    return {};
-                }
-            }
+    uint_fast32_t getCount(const std::string& count) noexcept {
+        if (!cpp::is_number(count)) {
+            return 0;
+        }
 
-            if (size == 0) {
-                size = counter;
-            } else if (counter != size) {
-                return {0, {}};
-            }
+        return std::strtoul(count.c_str(), nullptr, 10);
+    }
 
-            counter = 0;
-            ++linesCounter;
-        }
+    boost::multiprecision::mpz_int factorial(const uint_fast8_t size) noexcept {
+        boost::multiprecision::mpz_int result = 1;
 
-        if (linesCounter != size) {
-            return {0, {}};
+        for (uint_fast8_t i = 2; i <= size; ++i) {
+            result *= i;
         }
 
-        return {size, numbers};
+        return result;
     }
 
-    void printBoard(const LatinSquare& latinSquare) noexcept {
-        const auto& grid = latinSquare.grid();
-        std::string leftBar = "+", repeatedLeftBar, spaces, numberString;
-        leftBar.append(std::string(static_cast<uint_fast8_t>(std::log10(latinSquare.size()) + 1) + 2, '-'));
-        repeatedLeftBar = cpp::repeat(leftBar, latinSquare.size());
-        uint8_t number;
-
-        for (const auto& cell : grid) {
-            if (cell->rawColumn() == 0) {
-                std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                std::cout.put('+');
-                std::cout.put('\n');
-            }
+    const std::pair<uint_fast8_t, std::vector<uint_fast8_t>> convert(const std::string& filename) noexcept {
+        Parser parser(filename);
 
-            number = cell->number();
-            spaces = std::string(static_cast<uint_fast8_t>(std::log10(latinSquare.size()))
-                                 - static_cast<uint_fast8_t>(std::log10(++number)) + 1, ' ');
-            numberString = std::to_string(number);
-            std::cout.put('|');
-            std::cout.write(spaces.c_str(), spaces.size());
-            std::cout.write(numberString.c_str(), numberString.size());
-            std::cout.put(' ');
-
-            if (cell->rawColumn() == latinSquare.size() - 1) {
-                std::cout.put('|');
-                std::cout.put('\n');
-            }
+        if (!parser.next() || !parser.valid()) {
+            return {};
         }
 
-        std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-        std::cout.put('+');
-        std::cout.put('\n');
+        return {parser.size(), parser.numbers()};
     }
 
-    void printFile(const LatinSquare& latinSquare, const std::string filename) noexcept {
-        uint_fast16_t gridSize = latinSquare.size();
-        gridSize *= latinSquare.size();
-        const auto& grid = latinSquare.grid();
-        uint_fast8_t row = 0;
-        uint_fast8_t column = 0;
-        std::string number;
-        std::ofstream file(filename);
-
-        if (!file.is_open()) {
-            return;
-        }
-
-        for (uint_fast16_t index = 0; index < gridSize; ++index) {
-            number = std::to_string(grid[index]->number() + 1);
-            number += " ";
-            file.write(number.c_str(), number.size());
+    void normalize(const uint_fast8_t size, std::vector<uint_fast8_t>& numbers) noexcept {
+        // Every row in turn is relabelled to 0, 1, ..., size - 1 and the rows are then sorted by the first column.
+        // The lexicographically smallest result does not depend on the order of rows or on the names of numbers,
+        // so it keeps every count that is invariant under isotopy, such as the number of transversals.
+        std::vector<uint_fast8_t> labels(size), rows(size), candidate(numbers.size()), best;
 
-            if (++column == latinSquare.size()) {
-                column = 0;
-                ++row;
-                file.put('\n');
-            }
-        }
-    }
+        for (uint_fast8_t reference = 0; reference < size; ++reference) {
+            std::fill(labels.begin(), labels.end(), EMPTY);
 
-    const std::pair<uint_fast8_t, std::vector<uint_fast8_t>> symmetricConvert(const std::string& filename) noexcept {
-        std::ifstream file(filename);
+            for (uint_fast8_t column = 0; column < size; ++column) {
+                const auto number = numbers[reference * size + column];
 
-        if (!file) {
-            return {};
-        }
+                if (number >= size || labels[number] != EMPTY) {
+                    return;
+                }
 
-        std::vector<uint_fast8_t> numbers;
-        std::string line, word;
-        uint_fast8_t number, size = 1, counter = 0, linesCounter = 0;
+                labels[number] = column;
+            }
 
-        while (std::getline(file, line)) {
-            std::istringstream iss(line);
+            std::fill(rows.begin(), rows.end(), EMPTY);
 
-            while (iss >> word) {
-                number = std::strtoul(word.c_str(), nullptr, 10);
+            for (uint_fast8_t row = 0; row < size; ++row) {
+                const auto number = numbers[row * size];
 
-                if (number <= MAX_SIZE) {
-                    numbers.emplace_back(--number);
-                    ++counter;
-                } else {
-                    return {};
+                if (number >= size || rows[labels[number]] != EMPTY) {
+                    return;
                 }
+
+                rows[labels[number]] = row;
             }
 
-            if (counter != size) {
-                return {};
+            for (uint_fast8_t row = 0; row < size; ++row) {
+                for (uint_fast8_t column = 0; column < size; ++column) {
+                    const auto number = numbers[rows[row] * size + column];
+                    candidate[row * size + column] = number < size ? labels[number] : number;
+                }
             }
 
-            counter = 0;
-            ++linesCounter;
-            ++size;
+            if (best.empty() || candidate < best) {
+                best.swap(candidate);
+                candidate.resize(numbers.size());
+            }
         }
 
-        if (linesCounter != --size) {
+        numbers.swap(best);
+    }
+
+    void printBoard(const LatinSquare& latinSquare) noexcept {
+        Formatter formatter(latinSquare.size());
+        formatter.board(latinSquare.grid());
+        formatter.write(std::cout);
+    }
+
+    void printFile(const LatinSquare& latinSquare, Formatter& formatter, Writer& writer) noexcept {
+        formatter.file(latinSquare.grid());
+        formatter.write(writer);
+    }
+
+    const std::pair<uint_fast8_t, std::vector<uint_fast8_t>> symmetricConvert(const std::string& filename) noexcept {
+        Parser parser(filename);
+
+        if (!parser.nextTriangular() || !parser.valid()) {
             return {};
         }
 
-        return {size, numbers};
+        return {parser.size(), parser.numbers()};
     }
 
-    void printBoard(const SymmetricLatinSquare& symmetricLatinSquare) noexcept {
-        const auto& grid = symmetricLatinSquare.grid();
-        std::string leftBar = "+", repeatedLeftBar, spaces, numberString;
-        leftBar.append(std::string(static_cast<uint_fast8_t>(std::log10(symmetricLatinSquare.size()) + 1) + 2, '-'));
-        repeatedLeftBar = cpp::repeat(leftBar, symmetricLatinSquare.size());
-        uint8_t number;
-
-        for (const auto& cell : grid) {
-            if (cell->rawColumn() == 0) {
-                std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                std::cout.put('+');
-                std::cout.put('\n');
+    void symmetricNormalize(const uint_fast8_t size, std::vector<uint_fast8_t>& numbers) noexcept {
+        // The first column of the triangular grid is the first row of the square, so relabelling by it keeps the
+        // square symmetric.
+        std::vector<uint_fast8_t> labels(size, EMPTY);
+
+        for (uint_fast16_t row = 0, index = 0; row < size; index += ++row) {
+            if (numbers[index] >= size || labels[numbers[index]] != EMPTY) {
+                return;
             }
 
-            number = cell->number();
-            spaces = std::string(static_cast<uint_fast8_t>(std::log10(symmetricLatinSquare.size()))
-                                 - static_cast<uint_fast8_t>(std::log10(++number)) + 1, ' ');
-            numberString = std::to_string(number);
-            std::cout.put('|');
-            std::cout.write(spaces.c_str(), spaces.size());
-            std::cout.write(numberString.c_str(), numberString.size());
-            std::cout.put(' ');
-
-            if (cell->rawColumn() == symmetricLatinSquare.size() - 1) {
-                std::cout.put('|');
-                std::cout.put('\n');
+            labels[numbers[index]] = row;
+        }
+
+        for (auto& number : numbers) {
+            if (number != EMPTY) {
+                number = labels[number];
             }
         }
+    }
 
-        std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-        std::cout.put('+');
-        std::cout.put('\n');
+    void printBoard(const SymmetricLatinSquare& symmetricLatinSquare) noexcept {
+        Formatter formatter(symmetricLatinSquare.size());
+        formatter.board(symmetricLatinSquare.grid());
+        formatter.write(std::cout);
     }
 
     void printTriangularBoard(const SymmetricLatinSquare& symmetricLatinSquare) noexcept {
-        const auto& triangularGrid = symmetricLatinSquare.triangularGrid();
-        uint_fast16_t index = -1;
-        std::string leftBar = "+", repeatedLeftBar, spaces, numberString;
-        leftBar.append(std::string(static_cast<uint_fast8_t>(std::log10(symmetricLatinSquare.size()) + 1) + 2, '-'));
-        repeatedLeftBar = cpp::repeat(leftBar, symmetricLatinSquare.size());
-        uint8_t number;
-
-        for (uint_fast8_t row = 0; row < symmetricLatinSquare.size(); ++row) {
-            for (uint_fast8_t column = 0; column <= row; ++column) {
-                std::cout.write(leftBar.c_str(), leftBar.size());
-            }
-
-            std::cout.put('+');
-            std::cout.put('\n');
-
-            for (uint_fast8_t column = 0; column <= row; ++column) {
-                number = triangularGrid[++index]->number();
-                spaces = std::string(static_cast<uint_fast8_t>(std::log10(symmetricLatinSquare.size()))
-                                    - static_cast<uint_fast8_t>(std::log10(++number)) + 1, ' ');
-                numberString = std::to_string(number);
-                std::cout.put('|');
-                std::cout.write(spaces.c_str(), spaces.size());
-                std::cout.write(numberString.c_str(), numberString.size());
-                std::cout.put(' ');
-            }
+        Formatter formatter(symmetricLatinSquare.size());
+        formatter.triangularBoard(symmetricLatinSquare.triangularGrid());
+        formatter.write(std::cout);
+    }
 
-            std::cout.put('|');
-            std::cout.put('\n');
-        }
+    void printFile(
+        const SymmetricLatinSquare& symmetricLatinSquare, Formatter& formatter, Writer& writer) noexcept {
+        formatter.file(symmetricLatinSquare.grid());
+        formatter.write(writer);
+    }
 
-        std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-        std::cout.put('+');
-        std::cout.put('\n');
+    void printTriangularFile(
+        const SymmetricLatinSquare& symmetricLatinSquare, Formatter& formatter, Writer& writer) noexcept {
+        formatter.triangularFile(symmetricLatinSquare.triangularGrid());
+        formatter.write(writer);
     }
 
-    void printFile(const SymmetricLatinSquare& symmetricLatinSquare, const std::string filename) noexcept {
-        uint_fast16_t gridSize = symmetricLatinSquare.size();
-        gridSize *= symmetricLatinSquare.size();
-        const auto& grid = symmetricLatinSquare.grid();
-        uint_fast8_t row = 0;
-        uint_fast8_t column = 0;
-        std::string number;
-        std::ofstream file(filename);
-
-        if (!file.is_open()) {
-            return;
-        }
+    const std::tuple<size_t, boost::multiprecision::mpz_int, double> merge(
+        const std::vector<std::string>& filenames) noexcept {
+        boost::multiprecision::mpz_int latinSquaresCounter = 0;
+        double seconds = 0;
+        size_t shards = 0;
+        std::string line, number;
 
-        for (uint_fast16_t index = 0; index < gridSize; ++index) {
-            number = std::to_string(grid[index]->number() + 1);
-            number += " ";
-            file.write(number.c_str(), number.size());
+        for (const auto& filename : filenames) {
+            std::ifstream file(filename);
 
-            if (++column == symmetricLatinSquare.size()) {
-                column = 0;
-                ++row;
-                file.put('\n');
+            if (!file) {
+                return {};
             }
-        }
-    }
 
-    void printTriangularFile(const SymmetricLatinSquare& symmetricLatinSquare, const std::string filename) noexcept {
-        const auto& triangularGrid = symmetricLatinSquare.triangularGrid();
-        uint_fast16_t index = -1;
-        std::string number;
-        std::ofstream file(filename);
+            while (std::getline(file, line)) {
+                if (line.starts_with(LATIN_SQUARES)) {
+                    number = line.substr(LATIN_SQUARES.size());
 
-        if (!file.is_open()) {
-            return;
-        }
+                    if (!cpp::is_number(number)) {
+                        return {};
+                    }
 
-        for (uint_fast8_t row = 0; row < symmetricLatinSquare.size(); ++row) {
-            for (uint_fast8_t column = 0; column <= row; ++column) {
-                number = std::to_string(triangularGrid[++index]->number() + 1);
-                number += " ";
-                file.write(number.c_str(), number.size());
+                    latinSquaresCounter += boost::multiprecision::mpz_int(number);
+                    ++shards;
+                } else if (line.starts_with(TIME)) {
+                    seconds += std::strtod(line.c_str() + TIME.size(), nullptr);
+                }
             }
-
-            file.put('\n');
         }
+
+        return {shards, latinSquaresCounter, seconds};
     }
 }
@@ -1,28 +1,46 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <utility>
 
+#include <boost/multiprecision/gmp.hpp>
+
 #include "Constants.hpp"
+#include "Formatter.hpp"
 #include "LatinSquare.hpp"
 #include "SymmetricLatinSquare.hpp"
+#include "Writer.hpp"
 
 namespace LatinSquare {
     [[nodiscard]] Type getType(const std::string& type) noexcept;
+    [[nodiscard]] const std::pair<uint_fast32_t, uint_fast32_t> getShard(const std::string& shard) noexcept;
+    [[nodiscard]] uint_fast32_t getCount(const std::string& count) noexcept;
+    [[nodiscard]] boost::multiprecision::mpz_int factorial(const uint_fast8_t size) noexcept;
 
     [[nodiscard]] const std::pair<uint_fast8_t, std::vector<uint_fast8_t>> convert(
         const std::string& filename) noexcept;
 
+    void normalize(const uint_fast8_t size, std::vector<uint_fast8_t>& numbers) noexcept;
+
     void printBoard(const LatinSquare& latinSquare) noexcept;
-    void printFile(const LatinSquare& latinSquare, const std::string filename) noexcept;
+    void printFile(const LatinSquare& latinSquare, Formatter& formatter, Writer& writer) noexcept;
 
     [[nodiscard]] const std::pair<uint_fast8_t, std::vector<uint_fast8_t>> symmetricConvert(
         const std::string& filename) noexcept;
 
+    void symmetricNormalize(const uint_fast8_t size, std::vector<uint_fast8_t>& numbers) noexcept;
+
     void printBoard(const SymmetricLatinSquare& symmetricLatinSquare) noexcept;
     void printTriangularBoard(const SymmetricLatinSquare& symmetricLatinSquare) noexcept;
-    void printFile(const SymmetricLatinSquare& symmetricLatinSquare, const std::string filename) noexcept;
-    void printTriangularFile(const SymmetricLatinSquare& symmetricLatinSquare, const std::string filename) noexcept;
+    void printFile(
+        const SymmetricLatinSquare& symmetricLatinSquare, Formatter& formatter, Writer& writer) noexcept;
+    void printTriangularFile(
+        const SymmetricLatinSquare& symmetricLatinSquare, Formatter& formatter, Writer& writer) noexcept;
+
+    [[nodiscard]] const std::tuple<size_t, boost::multiprecision::mpz_int, double> merge(
+        const std::vector<std::string>& filenames) noexcept;
 }
@@ -0,0 +1,103 @@
+#include "Writer.hpp"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Constants.hpp"
+
+namespace LatinSquare {
+    Writer::Writer(const std::string& filename) noexcept
+        : file_(::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)), offset_(0), index_(0),
+          pending_(false), stopped_(false), failed_(false) {
+        if (file_ < 0) {
+            return;
+        }
+
+        buffers_[0].reserve(WRITER_BUFFER_SIZE);
+        buffers_[1].reserve(WRITER_BUFFER_SIZE);
+        thread_ = std::thread(&Writer::run, this);
+    }
+
+    Writer::~Writer() noexcept {
+        if (file_ < 0) {
+            return;
+        }
+
+        flush();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+
+        condition_.notify_all();
+        thread_.join();
+        ::close(file_);
+    }
+
+    void Writer::write(const std::string_view data) noexcept {
+        auto& buffer = buffers_[index_];
+        buffer.append(data);
+
+        if (buffer.size() >= WRITER_BUFFER_SIZE) {
+            submit();
+        }
+    }
+
+    void Writer::flush() noexcept {
+        if (file_ < 0) {
+            return;
+        }
+
+        if (!buffers_[index_].empty()) {
+            submit();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return !pending_; });
+    }
+
+    void Writer::submit() noexcept {
+        // The caller keeps filling the other buffer while the writer thread drains this one.
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return !pending_; });
+        index_ ^= 1;
+        pending_ = true;
+        lock.unlock();
+        condition_.notify_all();
+    }
+
+    void Writer::run() noexcept {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (true) {
+            condition_.wait(lock, [this] { return pending_ || stopped_; });
+
+            if (!pending_) {
+                return;
+            }
+
+            auto& buffer = buffers_[index_ ^ 1];
+            lock.unlock();
+            size_t written = 0;
+
+            while (written < buffer.size() && !failed_) {
+                const auto result = ::pwrite(file_, buffer.data() + written, buffer.size() - written, offset_);
+
+                if (result > 0) {
+                    written += result;
+                    offset_ += result;
+                } else if (result == 0 || errno != EINTR) {
+                    failed_ = true;
+                }
+            }
+
+            buffer.clear();
+            lock.lock();
+            pending_ = false;
+            condition_.notify_all();
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <sys/types.h>
+
+namespace LatinSquare {
+    class Writer {
+        public:
+            explicit Writer(const std::string& filename) noexcept;
+            ~Writer() noexcept;
+
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            [[nodiscard]] inline constexpr bool isOpen() const noexcept {
+                return file_ >= 0;
+            }
+
+            [[nodiscard]] inline bool failed() const noexcept {
+                return failed_.load();
+            }
+
+            void write(const std::string_view data) noexcept;
+            void flush() noexcept;
+
+        private:
+            void submit() noexcept;
+            void run() noexcept;
+
+            int file_;
+            off_t offset_;
+            std::array<std::string, 2> buffers_;
+            uint_fast8_t index_;
+            bool pending_;
+            bool stopped_;
+            std::atomic<bool> failed_;
+            std::mutex mutex_;
+            std::condition_variable condition_;
+            std::thread thread_;
+    };
+}
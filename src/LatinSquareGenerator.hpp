@@ -0,0 +1,14 @@
+#pragma once
+
+#include "LatinSquare/Cache.hpp"
+#include "LatinSquare/Constants.hpp"
+#include "LatinSquare/Formatter.hpp"
+#include "LatinSquare/Generator.hpp"
+#include "LatinSquare/LatinSquare.hpp"
+#include "LatinSquare/Parser.hpp"
+#include "LatinSquare/SymmetricLatinSquare.hpp"
+#include "LatinSquare/Utils.hpp"
+#include "LatinSquare/Writer.hpp"
+#include "Transversal/Constants.hpp"
+#include "Transversal/Generator.hpp"
+#include "Transversal/Utils.hpp"
@@ -1,28 +1,276 @@
 #include "Main.hpp"
 
+#include <array>
+#include <cerrno>
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <vector>
 
-#include "LatinSquare/Constants.hpp"
-#include "LatinSquare/Generator.hpp"
-#include "LatinSquare/Utils.hpp"
-#include "Transversal/Constants.hpp"
-#include "Transversal/Generator.hpp"
-#include "Transversal/Utils.hpp"
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "LatinSquareGenerator.hpp"
 
 void setup() {
     std::ios::sync_with_stdio(false);
     std::cin.tie(nullptr);
 }
 
-int main(int argc, char* argv[]) {
-    setup();
-    auto latinSquareGenerator = LatinSquare::Generator();
-    auto transversalGenerator = Transversal::Generator();
+void skip(const LatinSquare::Parser& parser) {
+    std::cout.write(Transversal::INVALID_SQUARE.data(), Transversal::INVALID_SQUARE.length());
+    std::cout << parser.block() << std::endl;
+}
+
+std::string cacheKey(const int argc, char* argv[], const std::string& shard) {
+    const std::string_view option = argv[1];
+    std::string key(option);
+    key.push_back(' ');
+    key.append(shard);
+    key.push_back(' ');
+
+    if (argc == 4
+        && (option.compare(LatinSquare::LATIN_SQUARES_COUNT) == 0
+            || option.compare(LatinSquare::SYMMETRIC_LATIN_SQUARES_COUNT) == 0
+            || option.compare(Transversal::TRANSVERSALS_MINMAX) == 0
+            || option.compare(Transversal::SYMMETRIC_TRANSVERSALS_MINMAX) == 0
+            || option.compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_MINMAX) == 0)) {
+        const uint_fast8_t size = std::strtoul(argv[2], nullptr, 10);
+        const LatinSquare::Type type = LatinSquare::getType(argv[3]);
+
+        if (size == 0 || size > LatinSquare::MAX_SIZE || type == LatinSquare::Type::Unknown) {
+            return {};
+        }
+
+        key.append(std::to_string(size));
+        key.push_back(' ');
+        key.append(argv[3]);
+        return key;
+    }
+
+    const auto isFull = option.compare(LatinSquare::LATIN_SQUARES_TEMPLATE_COUNT) == 0
+                        || option.compare(Transversal::TRANSVERSALS_TEMPLATE) == 0
+                        || option.compare(Transversal::TRANSVERSALS_COUNT) == 0;
+    const auto isTriangular = option.compare(LatinSquare::SYMMETRIC_LATIN_SQUARES_TEMPLATE_COUNT) == 0
+                              || option.compare(Transversal::SYMMETRIC_TRANSVERSALS_TEMPLATE) == 0
+                              || option.compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_TEMPLATE) == 0
+                              || option.compare(Transversal::SYMMETRIC_TRANSVERSALS_COUNT) == 0
+                              || option.compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_COUNT) == 0;
+
+    if (argc != 3 || (!isFull && !isTriangular)
+        || std::string_view(argv[2]).compare(LatinSquare::STANDARD_INPUT) == 0) {
+        return {};
+    }
+
+    // Counting transversals does not depend on the order of rows or on the names of numbers.
+    const auto isCount = option.compare(Transversal::TRANSVERSALS_COUNT) == 0
+                         || option.compare(Transversal::SYMMETRIC_TRANSVERSALS_COUNT) == 0
+                         || option.compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_COUNT) == 0;
+    LatinSquare::Parser parser(argv[2]);
+    auto squares = 0;
+
+    while (isFull ? parser.next() : parser.nextTriangular()) {
+        if (!parser.valid()) {
+            return {};
+        }
+
+        auto numbers = parser.numbers();
+
+        if (isCount) {
+            if (isFull) {
+                LatinSquare::normalize(parser.size(), numbers);
+            } else {
+                LatinSquare::symmetricNormalize(parser.size(), numbers);
+            }
+        }
+
+        key.push_back(static_cast<char>(parser.size()));
+        key.append(numbers.begin(), numbers.end());
+        ++squares;
+    }
+
+    return squares ? key : std::string();
+}
+
+int run(int argc, char* argv[], LatinSquare::Generator& latinSquareGenerator,
+    Transversal::Generator& transversalGenerator) {
+    latinSquareGenerator.shard(0, 1);
+    transversalGenerator.shard(0, 1);
+    transversalGenerator.threads(1);
+    transversalGenerator.countMaximum(false);
+    transversalGenerator.distinct(false);
+    latinSquareGenerator.propagation(false);
+    latinSquareGenerator.backjumping(false);
+    auto useCache = true;
+    auto propagation = false;
+    std::string shard;
+
+    if (argc > 2 && std::string_view(argv[argc - 1]).compare(LatinSquare::NO_CACHE) == 0) {
+        useCache = false;
+        --argc;
+    }
+
+    if (argc > 2 && std::string_view(argv[argc - 1]).compare(LatinSquare::PROPAGATION) == 0) {
+        const std::string_view option = argv[1];
+
+        if (option.compare(LatinSquare::LATIN_SQUARES_TEMPLATE_RANDOM) != 0
+            && option.compare(LatinSquare::LATIN_SQUARES_TEMPLATE_FILE) != 0
+            && option.compare(LatinSquare::LATIN_SQUARES_TEMPLATE_COUNT) != 0) {
+            std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
+            return 0;
+        }
+
+        latinSquareGenerator.propagation(true);
+        propagation = true;
+        --argc;
+    }
+
+    if (argc > 2 && std::string_view(argv[argc - 1]).compare(LatinSquare::BACKJUMPING) == 0) {
+        const std::string_view option = argv[1];
 
+        if (propagation || (option.compare(LatinSquare::LATIN_SQUARES_TEMPLATE_RANDOM) != 0
+                            && option.compare(LatinSquare::LATIN_SQUARES_TEMPLATE_FILE) != 0)) {
+            std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
+            return 0;
+        }
+
+        latinSquareGenerator.backjumping(true);
+        --argc;
+    }
+
+    if (argc > 2 && std::string_view(argv[argc - 1]).compare(LatinSquare::MAXIMUM_COUNT) == 0) {
+        if (std::string_view(argv[1]).compare(Transversal::TRANSVERSALS_PARTIAL) != 0) {
+            std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
+            return 0;
+        }
+
+        transversalGenerator.countMaximum(true);
+        --argc;
+    }
+
+    if (argc > 2 && std::string_view(argv[argc - 1]).compare(LatinSquare::DISTINCT) == 0) {
+        if (std::string_view(argv[1]).compare(Transversal::TRANSVERSALS_RANDOM_BATCH) != 0) {
+            std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
+            return 0;
+        }
+
+        transversalGenerator.distinct(true);
+        --argc;
+    }
+
+    if (argc > 3 && std::string_view(argv[argc - 2]).compare(LatinSquare::SHARD) == 0) {
+        const auto [index, count] = LatinSquare::getShard(argv[argc - 1]);
+        const std::string_view option = argv[1];
+
+        if (!count || (option.compare(LatinSquare::LATIN_SQUARES_COUNT) != 0
+                       && option.compare(LatinSquare::LATIN_SQUARES_TEMPLATE_COUNT) != 0
+                       && option.compare(Transversal::TRANSVERSALS_MINMAX) != 0
+                       && option.compare(Transversal::TRANSVERSALS_TEMPLATE) != 0)) {
+            std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
+            return 0;
+        }
+
+        latinSquareGenerator.shard(index, count);
+        transversalGenerator.shard(index, count);
+        shard = argv[argc - 1];
+
+        // Propagation prunes empty subtrees, so the shards of the two searches are numbered differently.
+        if (propagation) {
+            shard.push_back(' ');
+            shard.append(LatinSquare::PROPAGATION);
+        }
+
+        argc -= 2;
+    }
+
+    if (argc > 3 && std::string_view(argv[argc - 2]).compare(LatinSquare::THREADS) == 0) {
+        const auto count = LatinSquare::getCount(argv[argc - 1]);
+        const std::string_view option = argv[1];
+
+        if (!count || (option.compare(Transversal::TRANSVERSALS_RANDOM_BATCH) != 0
+                       && option.compare(Transversal::TRANSVERSALS_ENUMERATE) != 0
+                       && option.compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_COUNT) != 0
+                       && option.compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_MINMAX) != 0)) {
+            std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
+            return 0;
+        }
+
+        transversalGenerator.threads(count);
+        argc -= 2;
+    }
+
+    uint_fast32_t squares = 1;
+
+    if (argc > 3 && std::string_view(argv[argc - 2]).compare(LatinSquare::SQUARES) == 0) {
+        squares = LatinSquare::getCount(argv[argc - 1]);
+        const std::string_view option = argv[1];
+
+        if (!squares || (option.compare(LatinSquare::LATIN_SQUARES_FILE) != 0
+                         && option.compare(LatinSquare::LATIN_SQUARES_TEMPLATE_FILE) != 0
+                         && option.compare(LatinSquare::SYMMETRIC_LATIN_SQUARES_FILE) != 0
+                         && option.compare(LatinSquare::SYMMETRIC_LATIN_SQUARES_TEMPLATE_FILE) != 0)) {
+            std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
+            return 0;
+        }
+
+        argc -= 2;
+    }
+
+    const auto key = useCache ? cacheKey(argc, argv, shard) : std::string();
+
+    if (key.empty()) {
+        if (!dispatch(argc, argv, squares, latinSquareGenerator, transversalGenerator)) {
+            std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
+        }
+
+        return 0;
+    }
+
+    LatinSquare::Cache cache(LatinSquare::Cache::filename());
+    std::string value;
+    const auto start = std::chrono::steady_clock::now();
+
+    if (cache.find(key, value)) {
+        const auto stop = std::chrono::steady_clock::now();
+        const auto duration = std::chrono::duration<double, std::micro>(stop - start);
+        const auto seconds = duration.count() / 1000000.0;
+        std::string timeString;
+        timeString.append(LatinSquare::TIME);
+        timeString.append(std::to_string(seconds));
+        timeString.append(LatinSquare::SECONDS);
+        std::cout.write(value.c_str(), value.size());
+        std::cout.write(timeString.c_str(), timeString.size());
+        return 0;
+    }
+
+    std::ostringstream output;
+    const auto outputBuffer = std::cout.rdbuf(output.rdbuf());
+    const auto handled = dispatch(argc, argv, squares, latinSquareGenerator, transversalGenerator);
+    std::cout.rdbuf(outputBuffer);
+    value = output.str();
+
+    // The time line is left out, a cached result is reported with the time of its lookup.
+    if (const auto time = value.rfind(LatinSquare::TIME); handled && time != std::string::npos
+        && (time == 0 || value[time - 1] == '\n')) {
+        cache.insert(key, std::string_view(value).substr(0, time));
+    }
+
+    std::cout.write(value.c_str(), value.size());
+
+    if (!handled) {
+        std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
+    }
+
+    return 0;
+}
+
+bool dispatch(int argc, char* argv[], const uint_fast32_t squares, LatinSquare::Generator& latinSquareGenerator,
+    Transversal::Generator& transversalGenerator) {
     if (argc == 4 && std::string_view(argv[1]).compare(LatinSquare::LATIN_SQUARES_RANDOM) == 0) {
         const uint_fast8_t size = std::strtoul(argv[2], nullptr, 10);
         const LatinSquare::Type type = LatinSquare::getType(argv[3]);
@@ -39,7 +287,7 @@ int main(int argc, char* argv[]) {
             timeString.append(LatinSquare::SECONDS);
             LatinSquare::printBoard(latinSquare);
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 5 && std::string_view(argv[1]).compare(LatinSquare::LATIN_SQUARES_FILE) == 0) {
         const uint_fast8_t size = std::strtoul(argv[2], nullptr, 10);
@@ -48,8 +296,19 @@ int main(int argc, char* argv[]) {
 
         if (size > 0 && size <= LatinSquare::MAX_SIZE && type != LatinSquare::Type::Unknown
             && std::string_view(filename).compare("") != 0) {
+            LatinSquare::Writer writer(filename);
+            LatinSquare::Formatter formatter(size);
             const auto start = std::chrono::steady_clock::now();
-            const auto latinSquare = latinSquareGenerator.random(size, type);
+
+            for (uint_fast32_t square = 0; square < squares; ++square) {
+                if (square) {
+                    writer.write("\n");
+                }
+
+                const auto latinSquare = latinSquareGenerator.random(size, type);
+                LatinSquare::printFile(latinSquare, formatter, writer);
+            }
+
             const auto stop = std::chrono::steady_clock::now();
             const auto duration = std::chrono::duration<double, std::micro>(stop - start);
             const auto seconds = duration.count() / 1000000.0;
@@ -57,9 +316,8 @@ int main(int argc, char* argv[]) {
             timeString.append(LatinSquare::TIME);
             timeString.append(std::to_string(seconds));
             timeString.append(LatinSquare::SECONDS);
-            LatinSquare::printFile(latinSquare, filename);
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 4 && std::string_view(argv[1]).compare(LatinSquare::LATIN_SQUARES_COUNT) == 0) {
         const uint_fast8_t size = std::strtoul(argv[2], nullptr, 10);
@@ -78,7 +336,7 @@ int main(int argc, char* argv[]) {
             std::cout.write(LatinSquare::LATIN_SQUARES.data(), LatinSquare::LATIN_SQUARES.length());
             std::cout << count << std::endl;
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 3 && std::string_view(argv[1]).compare(LatinSquare::LATIN_SQUARES_TEMPLATE_RANDOM) == 0) {
         const auto [size, numbers] = LatinSquare::convert(argv[2]);
@@ -93,9 +351,15 @@ int main(int argc, char* argv[]) {
             timeString.append(LatinSquare::TIME);
             timeString.append(std::to_string(seconds));
             timeString.append(LatinSquare::SECONDS);
-            LatinSquare::printBoard(latinSquare);
+
+            if (latinSquare.notFilled()) {
+                std::cout.write(LatinSquare::NOT_COMPLETABLE.data(), LatinSquare::NOT_COMPLETABLE.length());
+            } else {
+                LatinSquare::printBoard(latinSquare);
+            }
+
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 4 && std::string_view(argv[1]).compare(LatinSquare::LATIN_SQUARES_TEMPLATE_FILE) == 0) {
         const auto [size, numbers] = LatinSquare::convert(argv[2]);
@@ -103,8 +367,25 @@ int main(int argc, char* argv[]) {
 
         if (size > 0 && size <= LatinSquare::MAX_SIZE && numbers.size()
             && std::string_view(filename).compare("") != 0) {
+            LatinSquare::Writer writer(filename);
+            LatinSquare::Formatter formatter(size);
             const auto start = std::chrono::steady_clock::now();
-            const auto latinSquare = latinSquareGenerator.random(size, numbers);
+
+            for (uint_fast32_t square = 0; square < squares; ++square) {
+                if (square) {
+                    writer.write("\n");
+                }
+
+                const auto latinSquare = latinSquareGenerator.random(size, numbers);
+
+                if (latinSquare.notFilled()) {
+                    std::cout.write(LatinSquare::NOT_COMPLETABLE.data(), LatinSquare::NOT_COMPLETABLE.length());
+                    break;
+                }
+
+                LatinSquare::printFile(latinSquare, formatter, writer);
+            }
+
             const auto stop = std::chrono::steady_clock::now();
             const auto duration = std::chrono::duration<double, std::micro>(stop - start);
             const auto seconds = duration.count() / 1000000.0;
@@ -112,9 +393,8 @@ int main(int argc, char* argv[]) {
             timeString.append(LatinSquare::TIME);
             timeString.append(std::to_string(seconds));
             timeString.append(LatinSquare::SECONDS);
-            LatinSquare::printFile(latinSquare, filename);
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 3 && std::string_view(argv[1]).compare(LatinSquare::LATIN_SQUARES_TEMPLATE_COUNT) == 0) {
         const auto [size, numbers] = LatinSquare::convert(argv[2]);
@@ -133,7 +413,7 @@ int main(int argc, char* argv[]) {
             std::cout.write(LatinSquare::LATIN_SQUARES.data(), LatinSquare::LATIN_SQUARES.length());
             std::cout << count << std::endl;
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 4 && std::string_view(argv[1]).compare(LatinSquare::SYMMETRIC_LATIN_SQUARES_RANDOM) == 0) {
         const uint_fast8_t size = std::strtoul(argv[2], nullptr, 10);
@@ -151,7 +431,7 @@ int main(int argc, char* argv[]) {
             timeString.append(LatinSquare::SECONDS);
             LatinSquare::printBoard(symmetricLatinSquare);
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 5 && std::string_view(argv[1]).compare(LatinSquare::SYMMETRIC_LATIN_SQUARES_FILE) == 0) {
         const uint_fast8_t size = std::strtoul(argv[2], nullptr, 10);
@@ -160,8 +440,19 @@ int main(int argc, char* argv[]) {
 
         if (size > 0 && size <= LatinSquare::MAX_SIZE && type != LatinSquare::Type::Unknown
             && std::string_view(filename).compare("") != 0) {
+            LatinSquare::Writer writer(filename);
+            LatinSquare::Formatter formatter(size);
             const auto start = std::chrono::steady_clock::now();
-            const auto symmetricLatinSquare = latinSquareGenerator.symmetricRandom(size, type);
+
+            for (uint_fast32_t square = 0; square < squares; ++square) {
+                if (square) {
+                    writer.write("\n");
+                }
+
+                const auto symmetricLatinSquare = latinSquareGenerator.symmetricRandom(size, type);
+                LatinSquare::printTriangularFile(symmetricLatinSquare, formatter, writer);
+            }
+
             const auto stop = std::chrono::steady_clock::now();
             const auto duration = std::chrono::duration<double, std::micro>(stop - start);
             const auto seconds = duration.count() / 1000000.0;
@@ -169,9 +460,8 @@ int main(int argc, char* argv[]) {
             timeString.append(LatinSquare::TIME);
             timeString.append(std::to_string(seconds));
             timeString.append(LatinSquare::SECONDS);
-            LatinSquare::printTriangularFile(symmetricLatinSquare, filename);
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 4 && std::string_view(argv[1]).compare(LatinSquare::SYMMETRIC_LATIN_SQUARES_COUNT) == 0) {
         const uint_fast8_t size = std::strtoul(argv[2], nullptr, 10);
@@ -190,7 +480,7 @@ int main(int argc, char* argv[]) {
             std::cout.write(LatinSquare::LATIN_SQUARES.data(), LatinSquare::LATIN_SQUARES.length());
             std::cout << count << std::endl;
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 3
                && std::string_view(argv[1]).compare(LatinSquare::SYMMETRIC_LATIN_SQUARES_TEMPLATE_RANDOM) == 0) {
@@ -208,7 +498,7 @@ int main(int argc, char* argv[]) {
             timeString.append(LatinSquare::SECONDS);
             LatinSquare::printBoard(symmetricLatinSquare);
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 4
                && std::string_view(argv[1]).compare(LatinSquare::SYMMETRIC_LATIN_SQUARES_TEMPLATE_FILE) == 0) {
@@ -217,8 +507,19 @@ int main(int argc, char* argv[]) {
 
         if (size > 0 && size <= LatinSquare::MAX_SIZE && numbers.size()
             && std::string_view(filename).compare("") != 0) {
+            LatinSquare::Writer writer(filename);
+            LatinSquare::Formatter formatter(size);
             const auto start = std::chrono::steady_clock::now();
-            const auto symmetricLatinSquare = latinSquareGenerator.symmetricRandom(size, numbers);
+
+            for (uint_fast32_t square = 0; square < squares; ++square) {
+                if (square) {
+                    writer.write("\n");
+                }
+
+                const auto symmetricLatinSquare = latinSquareGenerator.symmetricRandom(size, numbers);
+                LatinSquare::printTriangularFile(symmetricLatinSquare, formatter, writer);
+            }
+
             const auto stop = std::chrono::steady_clock::now();
             const auto duration = std::chrono::duration<double, std::micro>(stop - start);
             const auto seconds = duration.count() / 1000000.0;
@@ -226,9 +527,8 @@ int main(int argc, char* argv[]) {
             timeString.append(LatinSquare::TIME);
             timeString.append(std::to_string(seconds));
             timeString.append(LatinSquare::SECONDS);
-            LatinSquare::printTriangularFile(symmetricLatinSquare, filename);
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 3
                && std::string_view(argv[1]).compare(LatinSquare::SYMMETRIC_LATIN_SQUARES_TEMPLATE_COUNT) == 0) {
@@ -248,7 +548,7 @@ int main(int argc, char* argv[]) {
             std::cout.write(LatinSquare::LATIN_SQUARES.data(), LatinSquare::LATIN_SQUARES.length());
             std::cout << count << std::endl;
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 3 && std::string_view(argv[1]).compare(Transversal::TRANSVERSALS_RANDOM) == 0) {
         const auto [size, numbers] = LatinSquare::convert(argv[2]);
@@ -269,10 +569,35 @@ int main(int argc, char* argv[]) {
                 timeString.append(LatinSquare::SECONDS);
                 Transversal::printBoard(latinSquare, transversal);
                 std::cout.write(timeString.c_str(), timeString.size());
-                return 0;
+                return true;
             }
         }
-    } else if (argc == 3 && std::string_view(argv[1]).compare(Transversal::TRANSVERSALS_COUNT) == 0) {
+    } else if (argc == 4 && std::string_view(argv[1]).compare(Transversal::TRANSVERSALS_RANDOM_BATCH) == 0) {
+        const auto [size, numbers] = LatinSquare::convert(argv[2]);
+        const auto count = LatinSquare::getCount(argv[3]);
+
+        if (size > 0 && size <= LatinSquare::MAX_SIZE && numbers.size() && count) {
+            auto latinSquare = LatinSquare::LatinSquare(size, numbers);
+
+            if (!latinSquare.notFilled()) {
+                latinSquare.setRegions();
+                const auto start = std::chrono::steady_clock::now();
+                const auto transversals = transversalGenerator.randomBatch(latinSquare, count);
+                const auto stop = std::chrono::steady_clock::now();
+                const auto duration = std::chrono::duration<double, std::micro>(stop - start);
+                const auto seconds = duration.count() / 1000000.0;
+                std::string timeString;
+                timeString.append(LatinSquare::TIME);
+                timeString.append(std::to_string(seconds));
+                timeString.append(LatinSquare::SECONDS);
+                std::cout.write(Transversal::SAMPLED_TRANSVERSALS.data(), Transversal::SAMPLED_TRANSVERSALS.length());
+                std::cout << transversals.size() / size << std::endl;
+                Transversal::printColumns(size, transversals);
+                std::cout.write(timeString.c_str(), timeString.size());
+                return true;
+            }
+        }
+    } else if (argc == 3 && std::string_view(argv[1]).compare(Transversal::TRANSVERSALS_PARTIAL) == 0) {
         const auto [size, numbers] = LatinSquare::convert(argv[2]);
 
         if (size > 0 && size <= LatinSquare::MAX_SIZE && numbers.size()) {
@@ -281,7 +606,106 @@ int main(int argc, char* argv[]) {
             if (!latinSquare.notFilled()) {
                 latinSquare.setRegions();
                 const auto start = std::chrono::steady_clock::now();
-                const auto count = transversalGenerator.count(latinSquare);
+                auto transversal = transversalGenerator.partial(latinSquare);
+                const auto stop = std::chrono::steady_clock::now();
+                const auto duration = std::chrono::duration<double, std::micro>(stop - start);
+                const auto seconds = duration.count() / 1000000.0;
+                std::string timeString;
+                timeString.append(Transversal::TIME);
+                timeString.append(std::to_string(seconds));
+                timeString.append(Transversal::SECONDS);
+                std::cout.write(Transversal::MAX_PARTIAL.data(), Transversal::MAX_PARTIAL.length());
+                std::cout << transversal.size() << std::endl;
+
+                if (transversalGenerator.countMaximum()) {
+                    std::cout.write(
+                        Transversal::PARTIAL_TRANSVERSALS.data(), Transversal::PARTIAL_TRANSVERSALS.length());
+                    std::cout << transversalGenerator.maxCounter() << std::endl;
+                }
+
+                Transversal::printPartialBoard(latinSquare, transversal);
+                std::cout.write(timeString.c_str(), timeString.size());
+                return true;
+            }
+        }
+    } else if (argc == 3 && std::string_view(argv[1]).compare(Transversal::ORTHOGONAL_MATE) == 0) {
+        const auto [size, numbers] = LatinSquare::convert(argv[2]);
+
+        if (size > 0 && size <= LatinSquare::MAX_SIZE && numbers.size()) {
+            auto latinSquare = LatinSquare::LatinSquare(size, numbers);
+
+            if (!latinSquare.notFilled()) {
+                latinSquare.setRegions();
+                const auto start = std::chrono::steady_clock::now();
+                const auto mateNumbers = transversalGenerator.mate(latinSquare);
+                const auto stop = std::chrono::steady_clock::now();
+                const auto duration = std::chrono::duration<double, std::micro>(stop - start);
+                const auto seconds = duration.count() / 1000000.0;
+                std::string timeString;
+                timeString.append(Transversal::TIME);
+                timeString.append(std::to_string(seconds));
+                timeString.append(Transversal::SECONDS);
+                std::cout.write(Transversal::TRANSVERSALS.data(), Transversal::TRANSVERSALS.length());
+                std::cout << transversalGenerator.transversalsCounter() << std::endl;
+
+                if (mateNumbers.empty()) {
+                    std::cout.write(Transversal::NO_ORTHOGONAL_MATE.data(), Transversal::NO_ORTHOGONAL_MATE.length());
+                } else {
+                    LatinSquare::printBoard(LatinSquare::LatinSquare(size, mateNumbers));
+                }
+
+                std::cout.write(timeString.c_str(), timeString.size());
+                return true;
+            }
+        }
+    } else if (argc == 3 && std::string_view(argv[1]).compare(Transversal::DISJOINT_TRANSVERSALS) == 0) {
+        const auto [size, numbers] = LatinSquare::convert(argv[2]);
+
+        if (size > 0 && size <= LatinSquare::MAX_SIZE && numbers.size()) {
+            auto latinSquare = LatinSquare::LatinSquare(size, numbers);
+
+            if (!latinSquare.notFilled()) {
+                latinSquare.setRegions();
+                const auto start = std::chrono::steady_clock::now();
+                const auto packingNumbers = transversalGenerator.packing(latinSquare);
+                const auto stop = std::chrono::steady_clock::now();
+                const auto duration = std::chrono::duration<double, std::micro>(stop - start);
+                const auto seconds = duration.count() / 1000000.0;
+                std::string timeString;
+                timeString.append(Transversal::TIME);
+                timeString.append(std::to_string(seconds));
+                timeString.append(Transversal::SECONDS);
+                std::cout.write(Transversal::TRANSVERSALS.data(), Transversal::TRANSVERSALS.length());
+                std::cout << transversalGenerator.transversalsCounter() << std::endl;
+
+                if (packingNumbers.empty()) {
+                    std::cout.write(Transversal::TOO_MANY_TRANSVERSALS.data(),
+                        Transversal::TOO_MANY_TRANSVERSALS.length());
+                } else {
+                    std::cout.write(Transversal::DISJOINT.data(), Transversal::DISJOINT.length());
+                    std::cout << static_cast<uint_fast32_t>(transversalGenerator.packingSize()) << std::endl;
+
+                    if (transversalGenerator.packingSize()) {
+                        LatinSquare::printBoard(LatinSquare::LatinSquare(size, packingNumbers));
+                    }
+                }
+
+                std::cout.write(timeString.c_str(), timeString.size());
+                return true;
+            }
+        }
+    } else if (argc == 4 && std::string_view(argv[1]).compare(Transversal::TRANSVERSALS_ENUMERATE) == 0) {
+        const auto [size, numbers] = LatinSquare::convert(argv[2]);
+        const std::string filename = argv[3];
+
+        if (size > 0 && size <= LatinSquare::MAX_SIZE && numbers.size()
+            && std::string_view(filename).compare("") != 0) {
+            auto latinSquare = LatinSquare::LatinSquare(size, numbers);
+
+            if (!latinSquare.notFilled()) {
+                latinSquare.setRegions();
+                const auto start = std::chrono::steady_clock::now();
+                const auto count = transversalGenerator.enumerate(latinSquare, filename);
                 const auto stop = std::chrono::steady_clock::now();
                 const auto duration = std::chrono::duration<double, std::micro>(stop - start);
                 const auto seconds = duration.count() / 1000000.0;
@@ -292,8 +716,43 @@ int main(int argc, char* argv[]) {
                 std::cout.write(Transversal::TRANSVERSALS.data(), Transversal::TRANSVERSALS.length());
                 std::cout << count << std::endl;
                 std::cout.write(timeString.c_str(), timeString.size());
-                return 0;
+                return true;
+            }
+        }
+    } else if (argc == 3 && std::string_view(argv[1]).compare(Transversal::TRANSVERSALS_COUNT) == 0) {
+        LatinSquare::Parser parser(argv[2]);
+        auto seconds = 0.0;
+
+        while (parser.next()) {
+            if (!parser.valid()) {
+                skip(parser);
+                continue;
+            }
+
+            auto latinSquare = LatinSquare::LatinSquare(parser.size(), parser.numbers());
+
+            if (latinSquare.notFilled()) {
+                skip(parser);
+                continue;
             }
+
+            latinSquare.setRegions();
+            const auto start = std::chrono::steady_clock::now();
+            const auto count = transversalGenerator.count(latinSquare);
+            const auto stop = std::chrono::steady_clock::now();
+            const auto duration = std::chrono::duration<double, std::micro>(stop - start);
+            seconds += duration.count() / 1000000.0;
+            std::cout.write(Transversal::TRANSVERSALS.data(), Transversal::TRANSVERSALS.length());
+            std::cout << count << std::endl;
+        }
+
+        if (parser.block()) {
+            std::string timeString;
+            timeString.append(Transversal::TIME);
+            timeString.append(std::to_string(seconds));
+            timeString.append(Transversal::SECONDS);
+            std::cout.write(timeString.c_str(), timeString.size());
+            return true;
         }
     } else if (argc == 4 && std::string_view(argv[1]).compare(Transversal::TRANSVERSALS_MINMAX) == 0) {
         const uint_fast8_t size = std::strtoul(argv[2], nullptr, 10);
@@ -330,7 +789,7 @@ int main(int argc, char* argv[]) {
             }
 
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 3 && std::string_view(argv[1]).compare(Transversal::TRANSVERSALS_TEMPLATE) == 0) {
         const auto [size, numbers] = LatinSquare::convert(argv[2]);
@@ -367,7 +826,7 @@ int main(int argc, char* argv[]) {
             }
 
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 3 && std::string_view(argv[1]).compare(Transversal::SYMMETRIC_TRANSVERSALS_RANDOM) == 0) {
         const auto [size, numbers] = LatinSquare::symmetricConvert(argv[2]);
@@ -389,32 +848,44 @@ int main(int argc, char* argv[]) {
                 timeString.append(LatinSquare::SECONDS);
                 Transversal::printBoard(symmetricLatinSquare, transversal);
                 std::cout.write(timeString.c_str(), timeString.size());
-                return 0;
+                return true;
             }
         }
     } else if (argc == 3 && std::string_view(argv[1]).compare(Transversal::SYMMETRIC_TRANSVERSALS_COUNT) == 0) {
-        const auto [size, numbers] = LatinSquare::symmetricConvert(argv[2]);
+        LatinSquare::Parser parser(argv[2]);
+        auto seconds = 0.0;
 
-        if (size > 0 && size <= LatinSquare::MAX_SIZE && numbers.size()) {
-            auto symmetricLatinSquare = LatinSquare::SymmetricLatinSquare(size, numbers);
+        while (parser.nextTriangular()) {
+            if (!parser.valid()) {
+                skip(parser);
+                continue;
+            }
 
-            if (!symmetricLatinSquare.notFilled()) {
-                symmetricLatinSquare.fillGrid();
-                symmetricLatinSquare.setRegions();
-                const auto start = std::chrono::steady_clock::now();
-                const auto count = transversalGenerator.symmetricCount(symmetricLatinSquare);
-                const auto stop = std::chrono::steady_clock::now();
-                const auto duration = std::chrono::duration<double, std::micro>(stop - start);
-                const auto seconds = duration.count() / 1000000.0;
-                std::string timeString;
-                timeString.append(Transversal::TIME);
-                timeString.append(std::to_string(seconds));
-                timeString.append(Transversal::SECONDS);
-                std::cout.write(Transversal::TRANSVERSALS.data(), Transversal::TRANSVERSALS.length());
-                std::cout << count << std::endl;
-                std::cout.write(timeString.c_str(), timeString.size());
-                return 0;
+            auto symmetricLatinSquare = LatinSquare::SymmetricLatinSquare(parser.size(), parser.numbers());
+
+            if (symmetricLatinSquare.notFilled()) {
+                skip(parser);
+                continue;
             }
+
+            symmetricLatinSquare.fillGrid();
+            symmetricLatinSquare.setRegions();
+            const auto start = std::chrono::steady_clock::now();
+            const auto count = transversalGenerator.symmetricCount(symmetricLatinSquare);
+            const auto stop = std::chrono::steady_clock::now();
+            const auto duration = std::chrono::duration<double, std::micro>(stop - start);
+            seconds += duration.count() / 1000000.0;
+            std::cout.write(Transversal::TRANSVERSALS.data(), Transversal::TRANSVERSALS.length());
+            std::cout << count << std::endl;
+        }
+
+        if (parser.block()) {
+            std::string timeString;
+            timeString.append(Transversal::TIME);
+            timeString.append(std::to_string(seconds));
+            timeString.append(Transversal::SECONDS);
+            std::cout.write(timeString.c_str(), timeString.size());
+            return true;
         }
     } else if (argc == 4 && std::string_view(argv[1]).compare(Transversal::SYMMETRIC_TRANSVERSALS_MINMAX) == 0) {
         const uint_fast8_t size = std::strtoul(argv[2], nullptr, 10);
@@ -451,7 +922,7 @@ int main(int argc, char* argv[]) {
             }
 
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 3 && std::string_view(argv[1]).compare(Transversal::SYMMETRIC_TRANSVERSALS_TEMPLATE) == 0) {
         const auto [size, numbers] = LatinSquare::symmetricConvert(argv[2]);
@@ -488,33 +959,10 @@ int main(int argc, char* argv[]) {
             }
 
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
-    // } else if (argc == 3
-    //          && std::string_view(argv[1]).compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_RANDOM) == 0) {
-    //     const auto [size, numbers] = LatinSquare::symmetricConvert(argv[2]);
-
-    //     if (size > 0 && size <= LatinSquare::MAX_SIZE && numbers.size()) {
-    //         auto symmetricLatinSquare = LatinSquare::SymmetricLatinSquare(size, numbers);
-
-    //         if (!symmetricLatinSquare.notFilled()) {
-    //             symmetricLatinSquare.setNumberRegions();
-    //             const auto start = std::chrono::steady_clock::now();
-    //             auto transversal = transversalGenerator.symmetricTriangularRandom(symmetricLatinSquare);
-    //             const auto stop = std::chrono::steady_clock::now();
-    //             const auto duration = std::chrono::duration<double, std::micro>(stop - start);
-    //             const auto seconds = duration.count() / 1000000.0;
-    //             std::string timeString;
-    //             timeString.append(LatinSquare::TIME);
-    //             timeString.append(std::to_string(seconds));
-    //             timeString.append(LatinSquare::SECONDS);
-    //             Transversal::printTriangularBoard(symmetricLatinSquare, transversal);
-    //             std::cout.write(timeString.c_str(), timeString.size());
-    //             return 0;
-    //         }
-    //     }
     } else if (argc == 3
-               && std::string_view(argv[1]).compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_COUNT) == 0) {
+               && std::string_view(argv[1]).compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_RANDOM) == 0) {
         const auto [size, numbers] = LatinSquare::symmetricConvert(argv[2]);
 
         if (size > 0 && size <= LatinSquare::MAX_SIZE && numbers.size()) {
@@ -523,19 +971,54 @@ int main(int argc, char* argv[]) {
             if (!symmetricLatinSquare.notFilled()) {
                 symmetricLatinSquare.setNumberRegions();
                 const auto start = std::chrono::steady_clock::now();
-                const auto count = transversalGenerator.symmetricTriangularCount(symmetricLatinSquare);
+                auto transversal = transversalGenerator.symmetricTriangularRandom(symmetricLatinSquare);
                 const auto stop = std::chrono::steady_clock::now();
                 const auto duration = std::chrono::duration<double, std::micro>(stop - start);
                 const auto seconds = duration.count() / 1000000.0;
                 std::string timeString;
-                timeString.append(Transversal::TIME);
+                timeString.append(LatinSquare::TIME);
                 timeString.append(std::to_string(seconds));
-                timeString.append(Transversal::SECONDS);
-                std::cout.write(Transversal::TRANSVERSALS.data(), Transversal::TRANSVERSALS.length());
-                std::cout << count << std::endl;
+                timeString.append(LatinSquare::SECONDS);
+                Transversal::printTriangularBoard(symmetricLatinSquare, transversal);
                 std::cout.write(timeString.c_str(), timeString.size());
-                return 0;
+                return true;
+            }
+        }
+    } else if (argc == 3
+               && std::string_view(argv[1]).compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_COUNT) == 0) {
+        LatinSquare::Parser parser(argv[2]);
+        auto seconds = 0.0;
+
+        while (parser.nextTriangular()) {
+            if (!parser.valid()) {
+                skip(parser);
+                continue;
+            }
+
+            auto symmetricLatinSquare = LatinSquare::SymmetricLatinSquare(parser.size(), parser.numbers());
+
+            if (symmetricLatinSquare.notFilled()) {
+                skip(parser);
+                continue;
             }
+
+            symmetricLatinSquare.setNumberRegions();
+            const auto start = std::chrono::steady_clock::now();
+            const auto count = transversalGenerator.symmetricTriangularCount(symmetricLatinSquare);
+            const auto stop = std::chrono::steady_clock::now();
+            const auto duration = std::chrono::duration<double, std::micro>(stop - start);
+            seconds += duration.count() / 1000000.0;
+            std::cout.write(Transversal::TRANSVERSALS.data(), Transversal::TRANSVERSALS.length());
+            std::cout << count << std::endl;
+        }
+
+        if (parser.block()) {
+            std::string timeString;
+            timeString.append(Transversal::TIME);
+            timeString.append(std::to_string(seconds));
+            timeString.append(Transversal::SECONDS);
+            std::cout.write(timeString.c_str(), timeString.size());
+            return true;
         }
     } else if (argc == 4
                && std::string_view(argv[1]).compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_MINMAX) == 0) {
@@ -573,7 +1056,7 @@ int main(int argc, char* argv[]) {
             }
 
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
         }
     } else if (argc == 3
                && std::string_view(argv[1]).compare(Transversal::SYMMETRIC_TRIANGULAR_TRANSVERSALS_TEMPLATE) == 0) {
@@ -611,10 +1094,208 @@ int main(int argc, char* argv[]) {
             }
 
             std::cout.write(timeString.c_str(), timeString.size());
-            return 0;
+            return true;
+        }
+    } else if (argc > 2 && std::string_view(argv[1]).compare(LatinSquare::MERGE) == 0) {
+        const std::vector<std::string> filenames(argv + 2, argv + argc);
+        const auto [shards, counts, seconds] = Transversal::merge(filenames);
+
+        if (shards == filenames.size()) {
+            std::string timeString;
+            timeString.append(Transversal::TIME);
+            timeString.append(std::to_string(seconds));
+            timeString.append(Transversal::SECONDS);
+            std::cout.write(Transversal::MIN_TRANSVERSALS.data(), Transversal::MIN_TRANSVERSALS.length());
+            std::cout << counts[0].counter() << std::endl;
+            std::cout.write(Transversal::LATIN_SQUARES_MIN_TRANSVERSALS.data(),
+                Transversal::LATIN_SQUARES_MIN_TRANSVERSALS.length());
+            std::cout << counts[0].latinSquaresCounter() << std::endl;
+
+            if (!counts[0].latinSquare().notFilled()) {
+                LatinSquare::printBoard(counts[0].latinSquare());
+            }
+
+            std::cout.write(Transversal::MAX_TRANSVERSALS.data(), Transversal::MAX_TRANSVERSALS.length());
+            std::cout << counts[1].counter() << std::endl;
+            std::cout.write(Transversal::LATIN_SQUARES_MAX_TRANSVERSALS.data(),
+                Transversal::LATIN_SQUARES_MAX_TRANSVERSALS.length());
+            std::cout << counts[1].latinSquaresCounter() << std::endl;
+
+            if (!counts[1].latinSquare().notFilled()) {
+                LatinSquare::printBoard(counts[1].latinSquare());
+            }
+
+            std::cout.write(timeString.c_str(), timeString.size());
+            return true;
+        }
+
+        const auto [latinSquareShards, count, latinSquareSeconds] = LatinSquare::merge(filenames);
+
+        if (latinSquareShards == filenames.size()) {
+            std::string timeString;
+            timeString.append(LatinSquare::TIME);
+            timeString.append(std::to_string(latinSquareSeconds));
+            timeString.append(LatinSquare::SECONDS);
+            std::cout.write(LatinSquare::LATIN_SQUARES.data(), LatinSquare::LATIN_SQUARES.length());
+            std::cout << count << std::endl;
+            std::cout.write(timeString.c_str(), timeString.size());
+            return true;
         }
     }
 
-    std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
-    return 0;
+    return false;
+}
+
+void respond(const std::string& request, LatinSquare::Generator& latinSquareGenerator,
+    Transversal::Generator& transversalGenerator) {
+    std::istringstream stream(request);
+    std::vector<std::string> words = {std::string(LatinSquare::SERVE)};
+    std::string word;
+    auto readsInput = false;
+
+    while (stream >> word) {
+        readsInput = readsInput || word == LatinSquare::STANDARD_INPUT;
+        words.emplace_back(word);
+    }
+
+    std::vector<char*> arguments;
+    arguments.reserve(words.size() + 1);
+
+    for (auto& argument : words) {
+        arguments.emplace_back(argument.data());
+    }
+
+    arguments.emplace_back(nullptr);
+
+    // A served request cannot read its square from standard input, which belongs to the server.
+    if (readsInput) {
+        std::cout.write(LatinSquare::USAGE.data(), LatinSquare::USAGE.length());
+    } else {
+        run(words.size(), arguments.data(), latinSquareGenerator, transversalGenerator);
+    }
+
+    std::cout.write(LatinSquare::SERVE_END.data(), LatinSquare::SERVE_END.length());
+}
+
+int serve(const std::string& path) {
+    auto latinSquareGenerator = LatinSquare::Generator();
+    auto transversalGenerator = Transversal::Generator();
+    std::string request;
+
+    if (path.empty()) {
+        while (std::getline(std::cin, request)) {
+            if (!request.empty()) {
+                respond(request, latinSquareGenerator, transversalGenerator);
+                std::cout.flush();
+            }
+        }
+
+        return 0;
+    }
+
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address.sun_path)) {
+        return 1;
+    }
+
+    path.copy(address.sun_path, path.size());
+    const auto server = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(path.c_str());
+
+    if (server < 0 || ::bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+        || ::listen(server, SOMAXCONN) < 0) {
+        return 1;
+    }
+
+    const auto outputBuffer = std::cout.rdbuf();
+    std::ostringstream response;
+    std::array<char, 4096> chunk;
+    std::vector<pollfd> descriptors = {{server, POLLIN, 0}};
+    std::vector<std::string> pending = {""};
+    std::cout.rdbuf(response.rdbuf());
+
+    // Clients are multiplexed on one thread, so a single pair of warm generators answers every request in turn.
+    while (true) {
+        if (::poll(descriptors.data(), descriptors.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            break;
+        }
+
+        for (size_t index = descriptors.size() - 1; index > 0; --index) {
+            if (!descriptors[index].revents) {
+                continue;
+            }
+
+            const auto client = descriptors[index].fd;
+            const auto result = ::read(client, chunk.data(), chunk.size());
+            auto connected = result > 0 || (result < 0 && errno == EINTR);
+
+            if (result > 0) {
+                pending[index].append(chunk.data(), result);
+            }
+
+            size_t position;
+
+            while (connected && (position = pending[index].find('\n')) != std::string::npos) {
+                request = pending[index].substr(0, position);
+                pending[index].erase(0, position + 1);
+
+                if (request.empty() || request == "\r") {
+                    continue;
+                }
+
+                response.str("");
+                respond(request, latinSquareGenerator, transversalGenerator);
+                const auto text = response.str();
+                size_t written = 0;
+
+                while (connected && written < text.size()) {
+                    const auto sent = ::send(client, text.data() + written, text.size() - written, MSG_NOSIGNAL);
+
+                    if (sent > 0) {
+                        written += sent;
+                    } else if (sent == 0 || errno != EINTR) {
+                        connected = false;
+                    }
+                }
+            }
+
+            if (!connected) {
+                ::close(client);
+                descriptors.erase(descriptors.begin() + index);
+                pending.erase(pending.begin() + index);
+            }
+        }
+
+        if (descriptors[0].revents & POLLIN) {
+            const auto client = ::accept(server, nullptr, nullptr);
+
+            if (client >= 0) {
+                descriptors.push_back({client, POLLIN, 0});
+                pending.emplace_back();
+            }
+        }
+    }
+
+    std::cout.rdbuf(outputBuffer);
+    ::close(server);
+    ::unlink(path.c_str());
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    setup();
+
+    if ((argc == 2 || argc == 3) && std::string_view(argv[1]).compare(LatinSquare::SERVE) == 0) {
+        return serve(argc == 3 ? argv[2] : "");
+    }
+
+    auto latinSquareGenerator = LatinSquare::Generator();
+    auto transversalGenerator = Transversal::Generator();
+    return run(argc, argv, latinSquareGenerator, transversalGenerator);
 }
@@ -1,4 +1,17 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
+
+#include "LatinSquareGenerator.hpp"
+
 void setup();
+std::string cacheKey(const int argc, char* argv[], const std::string& shard);
+int run(int argc, char* argv[], LatinSquare::Generator& latinSquareGenerator,
+    Transversal::Generator& transversalGenerator);
+bool dispatch(int argc, char* argv[], const uint_fast32_t squares, LatinSquare::Generator& latinSquareGenerator,
+    Transversal::Generator& transversalGenerator);
+void respond(const std::string& request, LatinSquare::Generator& latinSquareGenerator,
+    Transversal::Generator& transversalGenerator);
+int serve(const std::string& path);
 int main(int arc, char* argv[]);
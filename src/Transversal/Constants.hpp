@@ -5,9 +5,18 @@
 
 namespace Transversal {
     static constexpr uint_fast32_t MAX_ITERATIONS = 1000;
+    static constexpr uint_fast8_t LEAF_SIZE = 8;
+    static constexpr uint_fast8_t SPLIT_DEPTH = 2;
+    static constexpr uint_fast32_t MAX_PACKING_TRANSVERSALS = 1 << 15;
+    static constexpr uint_fast32_t MAX_DUPLICATES = 100000;
 
     static constexpr std::string_view TRANSVERSALS_RANDOM = "-tr";
+    static constexpr std::string_view TRANSVERSALS_RANDOM_BATCH = "-trb";
     static constexpr std::string_view TRANSVERSALS_COUNT = "-tc";
+    static constexpr std::string_view TRANSVERSALS_ENUMERATE = "-te";
+    static constexpr std::string_view TRANSVERSALS_PARTIAL = "-tp";
+    static constexpr std::string_view ORTHOGONAL_MATE = "-om";
+    static constexpr std::string_view DISJOINT_TRANSVERSALS = "-td";
     static constexpr std::string_view TRANSVERSALS_MINMAX = "-tm";
     static constexpr std::string_view TRANSVERSALS_TEMPLATE = "-tt";
 
@@ -16,12 +25,19 @@ namespace Transversal {
     static constexpr std::string_view SYMMETRIC_TRANSVERSALS_MINMAX = "-stm";
     static constexpr std::string_view SYMMETRIC_TRANSVERSALS_TEMPLATE = "-stt";
 
-    // static constexpr std::string_view SYMMETRIC_TRIANGULAR_TRANSVERSALS_RANDOM = "-sttr";
+    static constexpr std::string_view SYMMETRIC_TRIANGULAR_TRANSVERSALS_RANDOM = "-sttr";
     static constexpr std::string_view SYMMETRIC_TRIANGULAR_TRANSVERSALS_COUNT = "-sttc";
     static constexpr std::string_view SYMMETRIC_TRIANGULAR_TRANSVERSALS_MINMAX = "-sttm";
     static constexpr std::string_view SYMMETRIC_TRIANGULAR_TRANSVERSALS_TEMPLATE = "-sttt";
 
     static constexpr std::string_view TRANSVERSALS = "Number of transversals: ";
+    static constexpr std::string_view SAMPLED_TRANSVERSALS = "Number of sampled transversals: ";
+    static constexpr std::string_view MAX_PARTIAL = "Maximum length of partial transversals: ";
+    static constexpr std::string_view PARTIAL_TRANSVERSALS = "Number of partial transversals of maximum length: ";
+    static constexpr std::string_view NO_ORTHOGONAL_MATE = "Orthogonal mate does not exist\n";
+    static constexpr std::string_view DISJOINT = "Maximum number of disjoint transversals: ";
+    static constexpr std::string_view TOO_MANY_TRANSVERSALS = "Too many transversals to search for disjoint ones\n";
+    static constexpr std::string_view INVALID_SQUARE = "Skipped invalid square in block ";
     static constexpr std::string_view MIN_TRANSVERSALS = "Minimum number of transversals: ";
     static constexpr std::string_view LATIN_SQUARES_MIN_TRANSVERSALS =
         "Number of Latin squares with minimum number of transversals: ";
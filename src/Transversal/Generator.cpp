@@ -1,23 +1,37 @@
 #include "Generator.hpp"
 
 // #include <iostream>
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 
 #include <cpp/random.hpp>
 
 #include "Constants.hpp"
 #include "LatinSquare/EntropyData.hpp"
 #include "LatinSquare/Region.hpp"
+#include "LatinSquare/Utils.hpp"
 #include "SymmetricCellUpdateData.hpp"
+#include "Utils.hpp"
 
 namespace Transversal {
     const std::vector<uint_fast16_t> Generator::random(LatinSquare::LatinSquare& latinSquare) noexcept {
         cpp::splitmix64 splitmix64;
+        return random(latinSquare, splitmix64);
+    }
+
+    const std::vector<uint_fast16_t> Generator::random(
+        LatinSquare::LatinSquare& latinSquare, cpp::splitmix64& splitmix64) noexcept {
         std::vector<uint_fast16_t> transversal;
         transversal.reserve(latinSquare.size());
 
         uint_fast16_t cellIndex;
         uint_fast8_t regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(latinSquare.size());
         backtrackingHistory_.reserve(latinSquare.size());
 
@@ -80,107 +94,775 @@ namespace Transversal {
         return transversal;
     }
 
+    // Every thread draws from its own copy of the square with its own random stream and clears it between draws. Each
+    // transversal is stored as the columns of its cells in row order, which is also the key of the set of found ones
+    // when only distinct transversals are wanted.
+    const std::string Generator::randomBatch(
+        LatinSquare::LatinSquare& latinSquare, const uint_fast32_t count) noexcept {
+        const auto size = latinSquare.size();
+        std::string transversals;
+
+        if (!count || noTransversals(latinSquare)) {
+            return transversals;
+        }
+
+        std::vector<uint_fast8_t> numbers;
+        numbers.reserve(latinSquare.grid().size());
+
+        for (const auto& cell : latinSquare.grid()) {
+            numbers.emplace_back(cell->number());
+        }
+
+        transversals.reserve(static_cast<size_t>(count) * size);
+        std::unordered_set<std::string> found;
+        std::mutex mutex;
+        uint_fast32_t sampled = 0;
+        uint_fast32_t duplicates = 0;
+        auto stop = false;
+        cpp::splitmix64 seeds;
+        std::vector<Generator> generators(threadsCount_);
+        std::vector<std::thread> threads;
+        threads.reserve(threadsCount_);
+
+        for (uint_fast32_t index = 0; index < threadsCount_; ++index) {
+            threads.emplace_back([this, &generators, &numbers, &transversals, &found, &mutex, &sampled, &duplicates,
+                                     &stop, size, count, index, seed = seeds.next()] {
+                LatinSquare::LatinSquare threadLatinSquare(size, numbers);
+                threadLatinSquare.setRegions();
+                cpp::splitmix64 splitmix64(seed);
+                std::string transversal(size, 0);
+
+                while (true) {
+                    const auto cellIndexes = generators[index].random(threadLatinSquare, splitmix64);
+                    threadLatinSquare.resetCellsAndRegions();
+
+                    for (const auto cellIndex : cellIndexes) {
+                        transversal[cellIndex / size] = static_cast<char>(cellIndex % size);
+                    }
+
+                    const std::lock_guard<std::mutex> lock(mutex);
+
+                    if (stop || sampled == count) {
+                        break;
+                    }
+
+                    if (cellIndexes.size() < size) {
+                        stop = true;
+                        break;
+                    }
+
+                    if (distinct_) {
+                        if (!found.insert(transversal).second) {
+                            stop = ++duplicates > MAX_DUPLICATES;
+                            continue;
+                        }
+
+                        duplicates = 0;
+                    }
+
+                    transversals.append(transversal);
+                    ++sampled;
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        return transversals;
+    }
+
     const boost::multiprecision::mpz_int Generator::count(LatinSquare::LatinSquare& latinSquare) noexcept {
-        transversalSize_ = 0;
         almostSize_ = latinSquare.size();
-        --almostSize_;
+        almostSize_ -= std::min(almostSize_, LEAF_SIZE);
 
         if (!almostSize_) {
             // std::cout << "Iterations: 1" << std::endl;
 
-            return 1;
+            return latinSquare.lastRegionsCount();
         }
 
-        regionIndex_ = LatinSquare::DEFAULT_REGION_INDEX;
+        if (noTransversals(latinSquare)) {
+            return 0;
+        }
 
-        updateHistory_.reserve(latinSquare.size());
-        backtrackingHistory_.reserve(latinSquare.size());
+        return count(latinSquare, 0);
+    }
 
-        transversalsCounter_ = 0;
-        counter_ = 0;
-        // iterations_ = 0;
+    // Cells selected or excluded before the call stay as they are, so only the transversals through the selected
+    // cells that avoid the excluded ones are counted.
+    const boost::multiprecision::mpz_int Generator::count(
+        LatinSquare::LatinSquare& latinSquare, const uint_fast8_t selected) noexcept {
+        if (selected >= almostSize_) {
+            return latinSquare.lastRegionsCount();
+        }
 
-        while (true) {
-            // ++iterations_;
+        return search(latinSquare, selected, almostSize_, updateHistory_, backtrackingHistory_,
+            [](const uint_fast16_t, const uint_fast8_t) { return true; },
+            [&latinSquare] { return latinSquare.lastRegionsCount(); });
+    }
 
-            if (transversalSize_ < almostSize_) {
-                auto& region = latinSquare.minEntropyRegion(regionIndex_);
+    // The search shared by counting and enumerating transversals. Every chosen cell is passed to descend together with
+    // the number of cells chosen so far, and the search goes below it only if descend returns true. Once the regions
+    // left are small enough, leaf completes the transversal in every possible way and returns how many there were.
+    template <typename Descend, typename Leaf>
+    boost::multiprecision::mpz_int Generator::search(LatinSquare::LatinSquare& latinSquare,
+        uint_fast8_t transversalSize, const uint_fast8_t almostSize, std::vector<UpdateData>& updateHistory,
+        std::vector<BacktrackingData>& backtrackingHistory, Descend&& descend, Leaf&& leaf) const noexcept {
+        uint_fast16_t cellIndex;
+        uint_fast8_t regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
+
+        if (!latinSquare.minEntropyRegion(regionIndex).entropy()) {
+            return 0;
+        }
+
+        updateHistory.clear();
+        backtrackingHistory.clear();
+        updateHistory.reserve(latinSquare.size());
+        backtrackingHistory.reserve(latinSquare.size());
+
+        boost::multiprecision::mpz_int transversalsCounter = 0;
+        uint_fast8_t counter = 0;
+
+        while (true) {
+            if (transversalSize < almostSize) {
+                auto& region = latinSquare.minEntropyRegion(regionIndex);
 
                 if (region.entropy()) {
-                    ++transversalSize_;
-                    regionIndex_ = LatinSquare::DEFAULT_REGION_INDEX;
-                    counter_ = 0;
+                    ++transversalSize;
+                    regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
+                    counter = 0;
 
-                    cellIndex_ = region.firstEnabledCellIndex();
-                    latinSquare.disable(cellIndex_);
+                    cellIndex = region.firstEnabledCellIndex();
+                    latinSquare.disable(cellIndex);
 
-                    updateHistory_.emplace_back(region.index(), cellIndex_, latinSquare.disableAndDecrease(cellIndex_));
-                    backtrackingHistory_.emplace_back(region.index(), cellIndex_);
+                    updateHistory.emplace_back(region.index(), cellIndex, latinSquare.disableAndDecrease(cellIndex));
+                    backtrackingHistory.emplace_back(region.index(), cellIndex);
+
+                    if (!descend(cellIndex, transversalSize)) {
+                        --transversalSize;
+                        counter = 1;
+
+                        regionIndex = updateHistory.back().regionIndex();
+
+                        latinSquare.enable(updateHistory.back().cellIndex());
+                        latinSquare.enableAndIncrease(updateHistory.back().indexes());
+
+                        updateHistory.pop_back();
+                    }
                 } else {
-                    --transversalSize_;
+                    --transversalSize;
 
-                    if (++counter_ > 1) {
-                        latinSquare.enableAndIncrease(backtrackingHistory_.back().cellIndex());
+                    if (++counter > 1) {
+                        latinSquare.enableAndIncrease(backtrackingHistory.back().cellIndex());
 
-                        regionIndex_ = backtrackingHistory_.back().regionIndex();
+                        regionIndex = backtrackingHistory.back().regionIndex();
 
-                        backtrackingHistory_.pop_back();
+                        backtrackingHistory.pop_back();
 
-                        while (backtrackingHistory_.size()
-                               && regionIndex_ == backtrackingHistory_.back().regionIndex()) {
-                            latinSquare.enableAndIncrease(backtrackingHistory_.back().cellIndex());
+                        while (backtrackingHistory.size() && regionIndex == backtrackingHistory.back().regionIndex()) {
+                            latinSquare.enableAndIncrease(backtrackingHistory.back().cellIndex());
 
-                            backtrackingHistory_.pop_back();
+                            backtrackingHistory.pop_back();
                         }
 
-                        if (updateHistory_.empty()) {
+                        if (updateHistory.empty()) {
                             break;
                         }
                     }
 
-                    regionIndex_ = updateHistory_.back().regionIndex();
+                    regionIndex = updateHistory.back().regionIndex();
 
-                    latinSquare.enable(updateHistory_.back().cellIndex());
-                    latinSquare.enableAndIncrease(updateHistory_.back().indexes());
+                    latinSquare.enable(updateHistory.back().cellIndex());
+                    latinSquare.enableAndIncrease(updateHistory.back().indexes());
 
-                    updateHistory_.pop_back();
+                    updateHistory.pop_back();
                 }
             } else {
-                --transversalSize_;
-                counter_ = 1;
-                transversalsCounter_ += latinSquare.lastNotChosenRegion().entropy();
+                --transversalSize;
+                counter = 1;
+                transversalsCounter += leaf();
 
-                regionIndex_ = updateHistory_.back().regionIndex();
+                regionIndex = updateHistory.back().regionIndex();
 
-                latinSquare.enable(updateHistory_.back().cellIndex());
-                latinSquare.enableAndIncrease(updateHistory_.back().indexes());
+                latinSquare.enable(updateHistory.back().cellIndex());
+                latinSquare.enableAndIncrease(updateHistory.back().indexes());
 
-                updateHistory_.pop_back();
+                updateHistory.pop_back();
             }
         }
 
-        // std::cout << "Iterations: " << iterations_ << std::endl;
+        return transversalsCounter;
+    }
 
-        return transversalsCounter_;
+    const boost::multiprecision::mpz_int Generator::enumerate(
+        LatinSquare::LatinSquare& latinSquare, const std::string& filename) const noexcept {
+        if (threadsCount_ > 1) {
+            return parallelEnumerate(latinSquare, filename);
+        }
+
+        LatinSquare::Writer writer(filename);
+        std::string transversals;
+        const auto transversalsCounter = enumerate(latinSquare, transversals, &writer, nullptr, true);
+        writer.write(transversals);
+
+        return transversalsCounter;
+    }
+
+    // The search of count, except that every transversal is appended to transversals as the column of its cell in each
+    // row, one byte per row. The cells of the rows chosen so far are kept in one buffer that the last rows complete in
+    // place. With a writer, transversals are handed over every time the buffer is full. With nodes, the subtrees at
+    // split depth are claimed one by one from the shared counter, and only the main thread completes the transversals
+    // of squares too small to reach that depth.
+    boost::multiprecision::mpz_int Generator::enumerate(LatinSquare::LatinSquare& latinSquare,
+        std::string& transversals, LatinSquare::Writer* writer, std::atomic<uint_fast64_t>* nodes,
+        const bool main) const noexcept {
+        const auto size = latinSquare.size();
+        std::string transversal(size, '\0');
+        uint_fast8_t almostSize = size;
+        almostSize -= std::min(almostSize, LEAF_SIZE);
+
+        if (!almostSize) {
+            return main ? latinSquare.lastRegionsTransversals(transversal, transversals) : 0;
+        }
+
+        if (noTransversals(latinSquare)) {
+            return 0;
+        }
+
+        std::vector<UpdateData> updateHistory;
+        std::vector<BacktrackingData> backtrackingHistory;
+        const auto leaves = !nodes || main || almostSize >= SPLIT_DEPTH;
+        uint_fast64_t node = 0;
+        uint_fast64_t claimedNode = nodes ? nodes->fetch_add(1, std::memory_order_relaxed) : 0;
+
+        return search(latinSquare, 0, almostSize, updateHistory, backtrackingHistory,
+            [&](const uint_fast16_t cellIndex, const uint_fast8_t transversalSize) {
+                transversal[cellIndex / size] = static_cast<char>(cellIndex % size);
+
+                if (!nodes || transversalSize != SPLIT_DEPTH) {
+                    return true;
+                }
+
+                if (node++ != claimedNode) {
+                    return false;
+                }
+
+                claimedNode = nodes->fetch_add(1, std::memory_order_relaxed);
+                return true;
+            },
+            [&]() -> uint_fast64_t {
+                if (!leaves) {
+                    return 0;
+                }
+
+                const auto transversalsCounter = latinSquare.lastRegionsTransversals(transversal, transversals);
+
+                if (writer && transversals.size() >= LatinSquare::WRITER_BUFFER_SIZE) {
+                    writer->write(transversals);
+                    transversals.clear();
+                }
+
+                return transversalsCounter;
+            });
+    }
+
+    // Consecutive squares of the search share every cell filled above the depth where their histories diverge, so the
+    // transversals avoiding the cells filled below it, the frontier, are counted once and cached for that depth. The
+    // transversals through the frontier are split by the deepest frontier cell they contain, and the partial sums
+    // give the cached counts of all deeper frontiers for the next squares.
+    const boost::multiprecision::mpz_int Generator::incrementalCount(
+        LatinSquare::LatinSquare& latinSquare, const uint_fast16_t lastIndex) noexcept {
+        almostSize_ = latinSquare.size();
+        almostSize_ -= std::min(almostSize_, LEAF_SIZE);
+
+        if (!almostSize_) {
+            return latinSquare.lastRegionsCount();
+        }
+
+        const uint_fast16_t depth = latinSquareUpdateHistory_.size();
+        uint_fast16_t divergence = 0;
+
+        while (divergence < depth && divergence < frontierIndexes_.size()
+               && latinSquareUpdateHistory_[divergence].index() == frontierIndexes_[divergence]
+               && latinSquareUpdateHistory_[divergence].number() == frontierNumbers_[divergence]) {
+            ++divergence;
+        }
+
+        const auto cached = frontierDepth_ <= divergence;
+
+        if (!cached && noTransversals(latinSquare)) {
+            frontierDepth_ = UINT_FAST16_MAX;
+            return 0;
+        }
+
+        frontierCells_.clear();
+        frontierCells_.emplace_back(lastIndex);
+
+        for (auto index = depth; index > divergence; --index) {
+            frontierCells_.emplace_back(latinSquareUpdateHistory_[index - 1].index());
+        }
+
+        frontierSums_.resize(frontierCells_.size() + 1);
+        frontierSums_[0] = 0;
+
+        for (size_t index = 0; index < frontierCells_.size(); ++index) {
+            latinSquare.disable(frontierCells_[index]);
+            frontierConflicts_ = latinSquare.disableAndDecrease(frontierCells_[index]);
+            frontierSums_[index + 1] = frontierSums_[index] + count(latinSquare, 1);
+            latinSquare.enable(frontierCells_[index]);
+            latinSquare.enableAndIncrease(frontierConflicts_);
+        }
+
+        boost::multiprecision::mpz_int transversalsCounter = frontierSums_.back();
+
+        if (cached) {
+            transversalsCounter += frontierCounters_[divergence];
+        } else {
+            transversalsCounter += count(latinSquare, 0);
+            frontierDepth_ = divergence;
+        }
+
+        for (const auto cellIndex : frontierCells_) {
+            latinSquare.enableAndIncrease(cellIndex);
+        }
+
+        frontierCounters_.resize(depth + 1);
+
+        for (size_t size = 1; size <= frontierCells_.size(); ++size) {
+            frontierCounters_[depth + 1 - size] = transversalsCounter - frontierSums_[size];
+        }
+
+        frontierIndexes_.resize(depth);
+        frontierNumbers_.resize(depth);
+
+        for (auto index = divergence; index < depth; ++index) {
+            frontierIndexes_[index] = latinSquareUpdateHistory_[index].index();
+            frontierNumbers_[index] = latinSquareUpdateHistory_[index].number();
+        }
+
+        return transversalsCounter;
+    }
+
+    // Every thread writes the transversals of the subtrees it claims to its own file, <filename>.<thread>.
+    boost::multiprecision::mpz_int Generator::parallelEnumerate(
+        LatinSquare::LatinSquare& latinSquare, const std::string& filename) const noexcept {
+        std::vector<uint_fast8_t> numbers;
+        numbers.reserve(latinSquare.grid().size());
+
+        for (const auto& cell : latinSquare.grid()) {
+            numbers.emplace_back(cell->number());
+        }
+
+        std::atomic<uint_fast64_t> nodes = 0;
+        std::vector<boost::multiprecision::mpz_int> transversalsCounters(threadsCount_);
+        std::vector<std::thread> threads;
+        threads.reserve(threadsCount_);
+
+        for (uint_fast32_t index = 0; index < threadsCount_; ++index) {
+            threads.emplace_back([this, &latinSquare, &filename, &numbers, &nodes, &transversalsCounters, index] {
+                LatinSquare::LatinSquare threadLatinSquare(latinSquare.size(), numbers);
+                threadLatinSquare.setRegions();
+                LatinSquare::Writer writer(filename + '.' + std::to_string(index));
+                std::string transversals;
+
+                transversalsCounters[index] = enumerate(threadLatinSquare, transversals, &writer, &nodes, !index);
+                writer.write(transversals);
+            });
+        }
+
+        boost::multiprecision::mpz_int transversalsCounter = 0;
+
+        for (uint_fast32_t index = 0; index < threadsCount_; ++index) {
+            threads[index].join();
+            transversalsCounter += transversalsCounters[index];
+        }
+
+        return transversalsCounter;
+    }
+
+    const std::vector<uint_fast16_t>& Generator::partial(LatinSquare::LatinSquare& latinSquare) noexcept {
+        const uint_fast16_t regionsSize = 3 * latinSquare.size();
+        candidates_.resize(regionsSize + 1);
+        disabledIndexes_.resize(regionsSize + 1);
+        partialTransversal_.clear();
+        maxTransversal_.clear();
+        maxCounter_ = 0;
+        maxLength_ = latinSquare.size() - noTransversals(latinSquare);
+
+        partial(latinSquare, 0);
+
+        return maxTransversal_;
     }
 
-    constexpr boost::multiprecision::mpz_int Generator::factorial(const uint_fast8_t size) noexcept {
-        boost::multiprecision::mpz_int result = 1;
+    // Every region with the lowest entropy is either used by one of its cells or left out of the partial transversal,
+    // so each partial transversal is reached exactly once. Cells are tried before leaving the region out, and the
+    // number of rows, columns and numbers still available bounds how much longer the current one can get.
+    void Generator::partial(LatinSquare::LatinSquare& latinSquare, const uint_fast8_t depth) noexcept {
+        const auto length = partialTransversal_.size();
+        const auto bound = std::min<size_t>(length + latinSquare.regionsBound(), maxLength_);
+
+        if (maxCounter_ && (bound < maxTransversal_.size() || (bound == maxTransversal_.size() && !countMaximum_))) {
+            return;
+        }
+
+        if (bound == length) {
+            if (!maxCounter_ || length > maxTransversal_.size()) {
+                maxTransversal_ = partialTransversal_;
+                maxCounter_ = 0;
+            }
+
+            ++maxCounter_;
+            return;
+        }
+
+        auto& region = latinSquare.minEntropyRegion(LatinSquare::DEFAULT_REGION_INDEX);
+        auto& candidates = candidates_[depth];
+        candidates = region.enabledCellIndexes();
+
+        for (const auto cellIndex : candidates) {
+            partialTransversal_.emplace_back(cellIndex);
+            latinSquare.disable(cellIndex);
+            disabledIndexes_[depth] = latinSquare.disableAndDecrease(cellIndex);
+
+            partial(latinSquare, depth + 1);
+
+            latinSquare.enable(cellIndex);
+            latinSquare.enableAndIncrease(disabledIndexes_[depth]);
+            partialTransversal_.pop_back();
+
+            if (!countMaximum_ && maxTransversal_.size() == maxLength_) {
+                break;
+            }
+        }
 
-        for (uint_fast8_t i = 2; i <= size; ++i) {
-            result *= i;
+        if (countMaximum_ || maxTransversal_.size() < maxLength_) {
+            region.enable();
+            partial(latinSquare, depth + 1);
+            region.enable();
         }
 
-        return result;
+        latinSquare.enableAndIncrease(candidates);
+    }
+
+    // A square has an orthogonal mate if and only if its cells split into size disjoint transversals, the cells of the
+    // k-th one holding number k in the mate. Transversals are kept as one byte per row and as a mask of their cells.
+    const std::vector<uint_fast8_t> Generator::mate(LatinSquare::LatinSquare& latinSquare) noexcept {
+        const auto size = latinSquare.size();
+        const uint_fast16_t gridSize = size * size;
+        transversals_.clear();
+        transversalsCounter_ = enumerate(latinSquare, transversals_, nullptr, nullptr, true);
+
+        const uint_fast32_t transversalsSize = transversals_.size() / size;
+        maskWords_ = (gridSize + 63) >> 6;
+        transversalMasks_.assign(transversalsSize * maskWords_, 0);
+
+        for (uint_fast32_t transversal = 0; transversal < transversalsSize; ++transversal) {
+            for (uint_fast8_t row = 0; row < size; ++row) {
+                const uint_fast16_t cellIndex = row * size + transversals_[transversal * size + row];
+                transversalMasks_[transversal * maskWords_ + (cellIndex >> 6)] |= 1ULL << (cellIndex & 63);
+            }
+        }
+
+        coveredMask_.assign(maskWords_, 0);
+        cellCounters_.resize(gridSize);
+        mateTransversals_.resize(size);
+        mateCandidates_.resize(size + 1);
+        mateCandidates_[0].resize(transversalsSize);
+
+        for (uint_fast32_t transversal = 0; transversal < transversalsSize; ++transversal) {
+            mateCandidates_[0][transversal] = transversal;
+        }
+
+        if (!mate(size, 0)) {
+            return {};
+        }
+
+        std::vector<uint_fast8_t> numbers(gridSize);
+
+        for (uint_fast8_t number = 0; number < size; ++number) {
+            for (uint_fast8_t row = 0; row < size; ++row) {
+                numbers[row * size + transversals_[mateTransversals_[number] * size + row]] = number;
+            }
+        }
+
+        return numbers;
+    }
+
+    // Exact cover in the order of dancing links: the cell contained in the fewest transversals disjoint from the chosen
+    // ones is covered first, and every level keeps only the candidates disjoint from all transversals chosen so far.
+    bool Generator::mate(const uint_fast8_t size, const uint_fast8_t depth) noexcept {
+        if (depth == size) {
+            return true;
+        }
+
+        const auto& candidates = mateCandidates_[depth];
+
+        if (candidates.size() < static_cast<size_t>(size - depth)) {
+            return false;
+        }
+
+        std::fill(cellCounters_.begin(), cellCounters_.end(), 0);
+
+        for (const auto transversal : candidates) {
+            for (uint_fast8_t row = 0; row < size; ++row) {
+                ++cellCounters_[row * size + transversals_[transversal * size + row]];
+            }
+        }
+
+        uint_fast16_t minCellIndex = 0;
+        uint_fast32_t minCounter = 0xFFFFFFFF;
+
+        for (uint_fast16_t cellIndex = 0; cellIndex < cellCounters_.size(); ++cellIndex) {
+            if (!(coveredMask_[cellIndex >> 6] & (1ULL << (cellIndex & 63))) && cellCounters_[cellIndex] < minCounter) {
+                minCellIndex = cellIndex;
+                minCounter = cellCounters_[cellIndex];
+            }
+        }
+
+        if (!minCounter) {
+            return false;
+        }
+
+        const uint_fast8_t row = minCellIndex / size;
+        const uint_fast8_t column = minCellIndex % size;
+        auto& nextCandidates = mateCandidates_[depth + 1];
+
+        for (const auto transversal : candidates) {
+            if (static_cast<uint_fast8_t>(transversals_[transversal * size + row]) != column) {
+                continue;
+            }
+
+            const auto mask = transversalMasks_.data() + transversal * maskWords_;
+            nextCandidates.clear();
+
+            for (const auto other : candidates) {
+                const auto otherMask = transversalMasks_.data() + other * maskWords_;
+                uint_fast16_t word = 0;
+
+                while (word < maskWords_ && !(mask[word] & otherMask[word])) {
+                    ++word;
+                }
+
+                if (word == maskWords_) {
+                    nextCandidates.emplace_back(other);
+                }
+            }
+
+            for (uint_fast16_t word = 0; word < maskWords_; ++word) {
+                coveredMask_[word] ^= mask[word];
+            }
+
+            mateTransversals_[depth] = transversal;
+
+            if (mate(size, depth + 1)) {
+                return true;
+            }
+
+            for (uint_fast16_t word = 0; word < maskWords_; ++word) {
+                coveredMask_[word] ^= mask[word];
+            }
+        }
+
+        return false;
+    }
+
+    // Disjoint transversals are the cliques of the graph joining every two transversals without a common cell. A mate
+    // is a clique of size, so the search for a smaller one only starts when the exact cover finds no mate.
+    const std::vector<uint_fast8_t> Generator::packing(LatinSquare::LatinSquare& latinSquare) noexcept {
+        const auto size = latinSquare.size();
+        auto numbers = mate(latinSquare);
+
+        if (numbers.size()) {
+            packingSize_ = size;
+            return numbers;
+        }
+
+        const uint_fast32_t transversalsSize = transversals_.size() / size;
+        packingSize_ = transversalsSize ? 1 : 0;
+        maxPackingSize_ = size - 1;
+
+        if (transversalsSize > MAX_PACKING_TRANSVERSALS) {
+            packingSize_ = 0;
+            return {};
+        }
+
+        packingWords_ = (transversalsSize + 63) >> 6;
+        std::vector<uint_fast64_t> adjacency(static_cast<size_t>(transversalsSize) * packingWords_, 0);
+        std::vector<uint_fast32_t> degrees(transversalsSize, 0);
+
+        for (uint_fast32_t transversal = 0; transversal < transversalsSize; ++transversal) {
+            const auto mask = transversalMasks_.data() + transversal * maskWords_;
+
+            for (uint_fast32_t other = transversal + 1; other < transversalsSize; ++other) {
+                const auto otherMask = transversalMasks_.data() + other * maskWords_;
+                uint_fast16_t word = 0;
+
+                while (word < maskWords_ && !(mask[word] & otherMask[word])) {
+                    ++word;
+                }
+
+                if (word == maskWords_) {
+                    adjacency[transversal * packingWords_ + (other >> 6)] |= 1ULL << (other & 63);
+                    adjacency[other * packingWords_ + (transversal >> 6)] |= 1ULL << (transversal & 63);
+                    ++degrees[transversal];
+                    ++degrees[other];
+                }
+            }
+        }
+
+        // Vertices with more neighbours come first, so that the greedy colouring gives tighter bounds early.
+        packingOrder_.resize(transversalsSize);
+
+        for (uint_fast32_t transversal = 0; transversal < transversalsSize; ++transversal) {
+            packingOrder_[transversal] = transversal;
+        }
+
+        std::stable_sort(packingOrder_.begin(), packingOrder_.end(),
+            [&degrees](const uint_fast32_t a, const uint_fast32_t b) { return degrees[a] > degrees[b]; });
+
+        packingNeighbours_.assign(static_cast<size_t>(transversalsSize) * packingWords_, 0);
+
+        for (uint_fast32_t vertex = 0; vertex < transversalsSize; ++vertex) {
+            const auto row = adjacency.data() + packingOrder_[vertex] * packingWords_;
+
+            for (uint_fast32_t other = 0; other < transversalsSize; ++other) {
+                if (row[packingOrder_[other] >> 6] & (1ULL << (packingOrder_[other] & 63))) {
+                    packingNeighbours_[vertex * packingWords_ + (other >> 6)] |= 1ULL << (other & 63);
+                }
+            }
+        }
+
+        packingCandidates_.assign(size + 1, std::vector<uint_fast64_t>(packingWords_, 0));
+        packingVertices_.resize(size + 1);
+        packingColors_.resize(size + 1);
+        packingUncolored_.resize(packingWords_);
+        packingColorClass_.resize(packingWords_);
+        packingClique_.assign(size, 0);
+        mateTransversals_.assign(size, 0);
+
+        for (uint_fast32_t vertex = 0; vertex < transversalsSize; ++vertex) {
+            packingCandidates_[0][vertex >> 6] |= 1ULL << (vertex & 63);
+        }
+
+        if (transversalsSize) {
+            mateTransversals_[0] = packingOrder_[0];
+            packing(0);
+        }
+
+        numbers.assign(static_cast<size_t>(size) * size, LatinSquare::DEFAULT_NUMBER);
+
+        for (uint_fast8_t number = 0; number < packingSize_; ++number) {
+            for (uint_fast8_t row = 0; row < size; ++row) {
+                numbers[row * size + transversals_[mateTransversals_[number] * size + row]] = number;
+            }
+        }
+
+        return numbers;
+    }
+
+    // Bitset branch and bound for maximum cliques: the candidates are coloured greedily, every colour class being an
+    // independent set, and a vertex is expanded only if the clique plus its colour can beat the best one found.
+    void Generator::packing(const uint_fast8_t depth) noexcept {
+        auto& candidates = packingCandidates_[depth];
+        auto& vertices = packingVertices_[depth];
+        auto& colors = packingColors_[depth];
+        const uint_fast8_t minColor = packingSize_ > depth ? packingSize_ - depth + 1 : 1;
+        vertices.clear();
+        colors.clear();
+        std::copy(candidates.begin(), candidates.end(), packingUncolored_.begin());
+        uint_fast8_t color = 1;
+        uint_fast32_t firstWord = 0;
+
+        while (true) {
+            while (firstWord < packingWords_ && !packingUncolored_[firstWord]) {
+                ++firstWord;
+            }
+
+            if (firstWord == packingWords_) {
+                break;
+            }
+
+            std::copy(packingUncolored_.begin(), packingUncolored_.end(), packingColorClass_.begin());
+
+            for (uint_fast32_t word = firstWord; word < packingWords_; ++word) {
+                while (packingColorClass_[word]) {
+                    const uint_fast32_t vertex = (word << 6) | std::countr_zero(packingColorClass_[word]);
+                    const auto neighbours = packingNeighbours_.data() + vertex * packingWords_;
+                    packingUncolored_[word] &= ~(1ULL << (vertex & 63));
+                    packingColorClass_[word] &= ~(1ULL << (vertex & 63));
+
+                    for (uint_fast32_t other = word; other < packingWords_; ++other) {
+                        packingColorClass_[other] &= ~neighbours[other];
+                    }
+
+                    if (color >= minColor) {
+                        vertices.emplace_back(vertex);
+                        colors.emplace_back(color);
+                    }
+                }
+            }
+
+            ++color;
+        }
+
+        auto& nextCandidates = packingCandidates_[depth + 1];
+
+        for (auto index = vertices.size(); index-- > 0;) {
+            if (depth + colors[index] <= packingSize_ || packingSize_ == maxPackingSize_) {
+                return;
+            }
+
+            const auto vertex = vertices[index];
+            const auto neighbours = packingNeighbours_.data() + vertex * packingWords_;
+            packingClique_[depth] = vertex;
+            uint_fast64_t any = 0;
+
+            for (uint_fast32_t word = 0; word < packingWords_; ++word) {
+                nextCandidates[word] = candidates[word] & neighbours[word];
+                any |= nextCandidates[word];
+            }
+
+            if (any) {
+                packing(depth + 1);
+            } else if (depth + 1 > packingSize_) {
+                packingSize_ = depth + 1;
+
+                for (uint_fast8_t clique = 0; clique < packingSize_; ++clique) {
+                    mateTransversals_[clique] = packingOrder_[packingClique_[clique]];
+                }
+            }
+
+            candidates[vertex >> 6] &= ~(1ULL << (vertex & 63));
+        }
+    }
+
+    // Relabelling the symbols of a symmetric square keeps it symmetric and keeps its transversals, so every square with
+    // the first row 1, ..., n stands for n! squares of normal type.
+    void Generator::symmetricNormalMinMax(const uint_fast8_t size) noexcept {
+        const auto permutations = LatinSquare::factorial(size);
+
+        for (auto& symmetricLatinSquaresCounter : symmetricLatinSquaresCounters_) {
+            symmetricLatinSquaresCounter.multiply(permutations);
+        }
     }
 
     const std::vector<MinMaxData>& Generator::minMax(const uint_fast8_t size, const LatinSquare::Type type) noexcept {
         LatinSquare::LatinSquare latinSquare(size, type);
 
         boost::multiprecision::mpz_int transversalsCounter;
+        latinSquaresCounters_.clear();
         latinSquaresCounters_.reserve(2);
 
         if (latinSquare.notFilled() < 2) {
+            if (!inShard(0)) {
+                latinSquaresCounters_.emplace_back(0, 0, latinSquare);
+                latinSquaresCounters_.emplace_back(0, 0, latinSquare);
+
+                return latinSquaresCounters_;
+            }
+
             if (latinSquare.notFilled()) {
                 auto& cell = latinSquare.lastNotFilledCell();
 
@@ -210,12 +892,17 @@ namespace Transversal {
         uint_fast8_t number;
         LatinSquare::EntropyData entropyData;
 
+        latinSquareUpdateHistory_.clear();
+        latinSquareBacktrackingHistory_.clear();
         latinSquareUpdateHistory_.reserve(latinSquare.notFilled());
         latinSquareBacktrackingHistory_.reserve(latinSquare.notFilled());
 
-        latinSquaresCounters_.emplace_back(factorial(size), 1, latinSquare);
+        latinSquaresCounters_.emplace_back(LatinSquare::factorial(size), 1, latinSquare);
         latinSquaresCounters_.emplace_back(-1, 1, latinSquare);
         uint_fast16_t counter = 0;
+        shardNode_ = 0;
+        frontierIndexes_.clear();
+        frontierDepth_ = UINT_FAST16_MAX;
         // iterations_ = 0;
 
         while (true) {
@@ -239,6 +926,18 @@ namespace Transversal {
                         || cell.index() != latinSquareBacktrackingHistory_.back().index()) {
                         latinSquareBacktrackingHistory_.emplace_back(cell.index(), entropyData);
                     }
+
+                    if (notInShard(latinSquareUpdateHistory_.size())) {
+                        counter = 1;
+
+                        index = latinSquareUpdateHistory_.back().index();
+
+                        latinSquare.clearAndRemove(index, latinSquareUpdateHistory_.back().entropyData());
+                        latinSquare.restore(
+                            latinSquareUpdateHistory_.back().indexes(), latinSquareUpdateHistory_.back().number());
+
+                        latinSquareUpdateHistory_.pop_back();
+                    }
                 } else {
                     if (latinSquareUpdateHistory_.empty()) {
                         break;
@@ -268,13 +967,13 @@ namespace Transversal {
 
                 auto& cell = latinSquare.lastNotFilledCell();
 
-                if (cell.positiveEntropy()) {
+                if (cell.positiveEntropy() && inShard(latinSquareUpdateHistory_.size())) {
                     number = cell.firstNumber();
                     entropyData = cell.entropyData();
                     latinSquare.fillAndClear(cell, number);
 
                     latinSquare.setRegions();
-                    transversalsCounter = count(latinSquare);
+                    transversalsCounter = incrementalCount(latinSquare, cell.index());
 
                     if (transversalsCounter < latinSquaresCounters_[0].counter()) {
                         latinSquaresCounters_[0].set(transversalsCounter);
@@ -317,9 +1016,17 @@ namespace Transversal {
 
     const std::vector<MinMaxData>& Generator::minMax(LatinSquare::LatinSquare& latinSquare) noexcept {
         boost::multiprecision::mpz_int transversalsCounter;
+        latinSquaresCounters_.clear();
         latinSquaresCounters_.reserve(2);
 
         if (latinSquare.notFilled() < 2) {
+            if (!inShard(0)) {
+                latinSquaresCounters_.emplace_back(0, 0, latinSquare);
+                latinSquaresCounters_.emplace_back(0, 0, latinSquare);
+
+                return latinSquaresCounters_;
+            }
+
             if (latinSquare.notFilled()) {
                 auto& cell = latinSquare.lastNotFilledCell();
 
@@ -345,12 +1052,17 @@ namespace Transversal {
         uint_fast8_t number;
         LatinSquare::EntropyData entropyData;
 
+        latinSquareUpdateHistory_.clear();
+        latinSquareBacktrackingHistory_.clear();
         latinSquareUpdateHistory_.reserve(latinSquare.notFilled());
         latinSquareBacktrackingHistory_.reserve(latinSquare.notFilled());
 
-        latinSquaresCounters_.emplace_back(factorial(latinSquare.size()), 1, latinSquare);
+        latinSquaresCounters_.emplace_back(LatinSquare::factorial(latinSquare.size()), 1, latinSquare);
         latinSquaresCounters_.emplace_back(-1, 1, latinSquare);
         uint_fast16_t counter = 0;
+        shardNode_ = 0;
+        frontierIndexes_.clear();
+        frontierDepth_ = UINT_FAST16_MAX;
 
         while (true) {
             if (latinSquare.notFilled() > 1) {
@@ -371,6 +1083,18 @@ namespace Transversal {
                         || cell.index() != latinSquareBacktrackingHistory_.back().index()) {
                         latinSquareBacktrackingHistory_.emplace_back(cell.index(), entropyData);
                     }
+
+                    if (notInShard(latinSquareUpdateHistory_.size())) {
+                        counter = 1;
+
+                        index = latinSquareUpdateHistory_.back().index();
+
+                        latinSquare.clearAndRemove(index, latinSquareUpdateHistory_.back().entropyData());
+                        latinSquare.restore(
+                            latinSquareUpdateHistory_.back().indexes(), latinSquareUpdateHistory_.back().number());
+
+                        latinSquareUpdateHistory_.pop_back();
+                    }
                 } else {
                     if (latinSquareUpdateHistory_.empty()) {
                         break;
@@ -400,13 +1124,13 @@ namespace Transversal {
 
                 auto& cell = latinSquare.lastNotFilledCell();
 
-                if (cell.positiveEntropy()) {
+                if (cell.positiveEntropy() && inShard(latinSquareUpdateHistory_.size())) {
                     number = cell.firstNumber();
                     entropyData = cell.entropyData();
                     latinSquare.fillAndClear(cell, number);
 
                     latinSquare.setRegions();
-                    transversalsCounter = count(latinSquare);
+                    transversalsCounter = incrementalCount(latinSquare, cell.index());
 
                     if (transversalsCounter < latinSquaresCounters_[0].counter()) {
                         latinSquaresCounters_[0].set(transversalsCounter);
@@ -454,6 +1178,8 @@ namespace Transversal {
         uint_fast16_t cellIndex;
         uint_fast8_t regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(symmetricLatinSquare.size());
         backtrackingHistory_.reserve(symmetricLatinSquare.size());
 
@@ -521,16 +1247,18 @@ namespace Transversal {
         LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept {
         transversalSize_ = 0;
         almostSize_ = symmetricLatinSquare.size();
-        --almostSize_;
+        almostSize_ -= std::min(almostSize_, LEAF_SIZE);
 
         if (!almostSize_) {
             // std::cout << "Iterations: 1" << std::endl;
 
-            return 1;
+            return symmetricLatinSquare.lastRegionsCount();
         }
 
         regionIndex_ = LatinSquare::DEFAULT_REGION_INDEX;
 
+        updateHistory_.clear();
+        backtrackingHistory_.clear();
         updateHistory_.reserve(symmetricLatinSquare.size());
         backtrackingHistory_.reserve(symmetricLatinSquare.size());
 
@@ -587,7 +1315,7 @@ namespace Transversal {
             } else {
                 --transversalSize_;
                 counter_ = 1;
-                transversalsCounter_ += symmetricLatinSquare.lastNotChosenRegion().entropy();
+                transversalsCounter_ += symmetricLatinSquare.lastRegionsCount();
 
                 regionIndex_ = updateHistory_.back().regionIndex();
 
@@ -605,9 +1333,17 @@ namespace Transversal {
 
     const std::vector<SymmetricMinMaxData>& Generator::symmetricMinMax(
         const uint_fast8_t size, const LatinSquare::Type type) noexcept {
+        if (type == LatinSquare::Type::Normal) {
+            static_cast<void>(symmetricMinMax(size, LatinSquare::Type::Reduced));
+            symmetricNormalMinMax(size);
+
+            return symmetricLatinSquaresCounters_;
+        }
+
         LatinSquare::SymmetricLatinSquare symmetricLatinSquare(size, type);
 
         boost::multiprecision::mpz_int transversalsCounter;
+        symmetricLatinSquaresCounters_.clear();
         symmetricLatinSquaresCounters_.reserve(2);
 
         if (type == LatinSquare::Type::ReducedDiagonal) {
@@ -645,10 +1381,12 @@ namespace Transversal {
         uint_fast8_t number;
         LatinSquare::EntropyData entropyData;
 
+        latinSquareUpdateHistory_.clear();
+        latinSquareBacktrackingHistory_.clear();
         latinSquareUpdateHistory_.reserve(symmetricLatinSquare.notFilled());
         latinSquareBacktrackingHistory_.reserve(symmetricLatinSquare.notFilled());
 
-        symmetricLatinSquaresCounters_.emplace_back(factorial(size), 1, symmetricLatinSquare);
+        symmetricLatinSquaresCounters_.emplace_back(LatinSquare::factorial(size), 1, symmetricLatinSquare);
         symmetricLatinSquaresCounters_.emplace_back(-1, 1, symmetricLatinSquare);
         uint_fast16_t counter = 0;
         // iterations_ = 0;
@@ -753,6 +1491,7 @@ namespace Transversal {
     const std::vector<SymmetricMinMaxData>& Generator::symmetricMinMax(
         LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept {
         boost::multiprecision::mpz_int transversalsCounter;
+        symmetricLatinSquaresCounters_.clear();
         symmetricLatinSquaresCounters_.reserve(2);
 
         if (!symmetricLatinSquare.notFilled()) {
@@ -777,10 +1516,13 @@ namespace Transversal {
         uint_fast8_t number;
         LatinSquare::EntropyData entropyData;
 
+        latinSquareUpdateHistory_.clear();
+        latinSquareBacktrackingHistory_.clear();
         latinSquareUpdateHistory_.reserve(symmetricLatinSquare.notFilled());
         latinSquareBacktrackingHistory_.reserve(symmetricLatinSquare.notFilled());
 
-        symmetricLatinSquaresCounters_.emplace_back(factorial(symmetricLatinSquare.size()), 1, symmetricLatinSquare);
+        symmetricLatinSquaresCounters_.emplace_back(
+            LatinSquare::factorial(symmetricLatinSquare.size()), 1, symmetricLatinSquare);
         symmetricLatinSquaresCounters_.emplace_back(-1, 1, symmetricLatinSquare);
         uint_fast16_t counter = 0;
 
@@ -877,179 +1619,270 @@ namespace Transversal {
         return symmetricLatinSquaresCounters_;
     }
 
-    // const std::vector<uint_fast16_t> Generator::symmetricTriangularRandom(
-    //     LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept {
-    //     cpp::splitmix64 splitmix64;
-    //     std::vector<uint_fast16_t> transversal;
-    //     transversal.reserve(symmetricLatinSquare.size());
+    const std::vector<uint_fast16_t> Generator::symmetricTriangularRandom(
+        LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept {
+        cpp::splitmix64 splitmix64;
+        std::vector<uint_fast16_t> transversal;
+        transversal.reserve(symmetricLatinSquare.size());
 
-    //     uint_fast16_t cellIndex;
-    //     uint_fast8_t regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
+        uint_fast16_t cellIndex;
+        uint_fast8_t regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
 
-    //     symmetricUpdateHistory_.reserve(symmetricLatinSquare.size());
-    //     symmetricBacktrackingHistory_.reserve(symmetricLatinSquare.size());
+        symmetricUpdateHistory_.clear();
+        symmetricBacktrackingHistory_.clear();
+        symmetricUpdateHistory_.reserve(symmetricLatinSquare.size());
+        symmetricBacktrackingHistory_.reserve(symmetricLatinSquare.size());
 
-    //     uint_fast8_t counter = 0;
-    //     uint_fast32_t iterations = 0;
+        uint_fast8_t counter = 0;
+        uint_fast32_t iterations = 0;
 
-    //     while (transversal.size() < symmetricLatinSquare.size()) {
-    //         ++iterations;
+        while (transversal.size() < symmetricLatinSquare.size()) {
+            auto& region = symmetricLatinSquare.randomMinEntropyTriangularRegion(regionIndex);
 
-    //         auto& region = symmetricLatinSquare.randomMinEntropyTriangularRegion(regionIndex);
+            if (region.entropy()) {
+                regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
+                counter = 0;
 
-    //         if (region.entropy()) {
-    //             regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
-    //             counter = 0;
+                const auto& cellIndexes = region.triangularLocalEnabledCellIndexes();
+                cellIndex = cellIndexes[splitmix64.next() % cellIndexes.size()];
+                transversal.emplace_back(cellIndex);
+                const auto& symmetricCellUpdateData = symmetricLatinSquare.triangularDisable(cellIndex, region.index());
 
-    //             const auto& cellIndexes = region.triangularLocalEnabledCellIndexes();
-    //             cellIndex = cellIndexes[splitmix64.next() % cellIndexes.size()];
-    //             transversal.emplace_back(cellIndex);
-    //             const auto& symmetricCellUpdateData = symmetricLatinSquare.triangularDisable(cellIndex, region.index());
+                symmetricUpdateHistory_.emplace_back(region.index(), symmetricCellUpdateData,
+                    symmetricLatinSquare.triangularDisableAndDecrease(cellIndex, region.index()));
+                symmetricBacktrackingHistory_.emplace_back(region.index(), symmetricCellUpdateData);
+            } else {
+                if (++counter > 1) {
+                    regionIndex = symmetricBacktrackingHistory_.back().regionIndex();
 
-    //             symmetricUpdateHistory_.emplace_back(region.index(), symmetricCellUpdateData,
-    //                 symmetricLatinSquare.triangularDisableAndDecrease(cellIndex, region.index()));
-    //             symmetricBacktrackingHistory_.emplace_back(region.index(), symmetricCellUpdateData);
-    //         } else {
-    //             if (++counter > 1) {
-    //                 regionIndex = symmetricBacktrackingHistory_.back().regionIndex();
+                    symmetricLatinSquare.triangularEnableAndIncrease(
+                        symmetricBacktrackingHistory_.back().cellUpdateData()[0]);
 
-    //                 symmetricLatinSquare.triangularEnableAndIncrease(
-    //                     symmetricBacktrackingHistory_.back().cellUpdateData()[0]);
+                    symmetricBacktrackingHistory_.pop_back();
 
-    //                 symmetricBacktrackingHistory_.pop_back();
+                    while (symmetricBacktrackingHistory_.size()
+                           && regionIndex == symmetricBacktrackingHistory_.back().regionIndex()) {
+                        symmetricLatinSquare.triangularEnableAndIncrease(
+                            symmetricBacktrackingHistory_.back().cellUpdateData()[0]);
 
-    //                 while (symmetricBacktrackingHistory_.size()
-    //                        && regionIndex == symmetricBacktrackingHistory_.back().regionIndex()) {
-    //                     symmetricLatinSquare.triangularEnableAndIncrease(
-    //                         symmetricBacktrackingHistory_.back().cellUpdateData()[0]);
+                        symmetricBacktrackingHistory_.pop_back();
+                    }
 
-    //                     symmetricBacktrackingHistory_.pop_back();
-    //                 }
+                    if (symmetricUpdateHistory_.empty()) {
+                        break;
+                    }
+                }
 
-    //                 if (symmetricUpdateHistory_.empty()) {
-    //                     break;
-    //                 }
-    //             }
+                transversal.pop_back();
 
-    //             transversal.pop_back();
+                regionIndex = symmetricUpdateHistory_.back().regionIndex();
 
-    //             regionIndex = symmetricUpdateHistory_.back().regionIndex();
+                symmetricLatinSquare.triangularEnable(regionIndex, symmetricUpdateHistory_.back().cellUpdateData());
+                symmetricLatinSquare.triangularEnableAndIncrease(symmetricUpdateHistory_.back().otherCellsUpdateData());
 
-    //             symmetricLatinSquare.triangularEnable(regionIndex, symmetricUpdateHistory_.back().cellUpdateData());
-    //             symmetricLatinSquare.triangularEnableAndIncrease(symmetricUpdateHistory_.back().otherCellsUpdateData());
+                symmetricUpdateHistory_.pop_back();
+            }
 
-    //             symmetricUpdateHistory_.pop_back();
-    //         }
+            if (++iterations > MAX_ITERATIONS) {
+                while (symmetricUpdateHistory_.size()) {
+                    symmetricLatinSquare.triangularEnable(
+                        symmetricUpdateHistory_.back().regionIndex(), symmetricUpdateHistory_.back().cellUpdateData());
+                    symmetricLatinSquare.triangularEnableAndIncrease(
+                        symmetricUpdateHistory_.back().otherCellsUpdateData());
+
+                    symmetricUpdateHistory_.pop_back();
+                }
+
+                while (symmetricBacktrackingHistory_.size()) {
+                    symmetricLatinSquare.triangularEnableAndIncrease(
+                        symmetricBacktrackingHistory_.back().cellUpdateData()[0]);
 
-    //         if (iterations > MAX_ITERATIONS) {
-    //             symmetricLatinSquare.setNumberRegions();
+                    symmetricBacktrackingHistory_.pop_back();
+                }
+
+                regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
+                counter = 0;
 
-    //             transversal.clear();
-    //             updateHistory_.clear();
-    //             backtrackingHistory_.clear();
-    //             iterations = 0;
-    //         }
-    //     }
+                transversal.clear();
+                iterations = 0;
+            }
+        }
 
-    //     return transversal;
-    // }
+        return transversal;
+    }
 
     const boost::multiprecision::mpz_int Generator::symmetricTriangularCount(
         LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept {
-        transversalSize_ = 0;
-        almostSize_ = symmetricLatinSquare.size();
-        --almostSize_;
+        if (threadsCount_ > 1) {
+            return parallelSymmetricTriangularCount(symmetricLatinSquare);
+        }
 
-        if (!almostSize_) {
+        return symmetricTriangularCount(symmetricLatinSquare, nullptr, true);
+    }
+
+    boost::multiprecision::mpz_int Generator::symmetricTriangularCount(
+        LatinSquare::SymmetricLatinSquare& symmetricLatinSquare, std::atomic<uint_fast64_t>* nodes,
+        const bool main) const noexcept {
+        uint_fast8_t transversalSize = 0;
+        uint_fast8_t almostSize = symmetricLatinSquare.size();
+        --almostSize;
+
+        if (!almostSize) {
             // std::cout << "Iterations: 1" << std::endl;
 
-            return 1;
+            return main ? 1 : 0;
         }
 
-        regionIndex_ = LatinSquare::DEFAULT_REGION_INDEX;
+        uint_fast16_t cellIndex;
+        uint_fast8_t regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
+        std::vector<SymmetricUpdateData> symmetricUpdateHistory;
+        std::vector<SymmetricBacktrackingData> symmetricBacktrackingHistory;
 
-        symmetricUpdateHistory_.reserve(symmetricLatinSquare.size());
-        symmetricBacktrackingHistory_.reserve(symmetricLatinSquare.size());
+        symmetricUpdateHistory.reserve(symmetricLatinSquare.size());
+        symmetricBacktrackingHistory.reserve(symmetricLatinSquare.size());
 
-        transversalsCounter_ = 0;
-        counter_ = 0;
-        // iterations_ = 0;
+        boost::multiprecision::mpz_int transversalsCounter = 0;
+        uint_fast8_t counter = 0;
+        uint_fast64_t node = 0;
+        uint_fast64_t claimedNode = nodes ? nodes->fetch_add(1, std::memory_order_relaxed) : 0;
+        // boost::multiprecision::mpz_int iterations = 0;
 
         while (true) {
-            // ++iterations_;
+            // ++iterations;
 
-            if (transversalSize_ < almostSize_) {
-                auto& region = symmetricLatinSquare.minEntropyTriangularRegion(regionIndex_);
+            if (transversalSize < almostSize) {
+                auto& region = symmetricLatinSquare.minEntropyTriangularRegion(regionIndex);
 
                 if (region.entropy()) {
-                    ++transversalSize_;
-                    regionIndex_ = LatinSquare::DEFAULT_REGION_INDEX;
-                    counter_ = 0;
+                    ++transversalSize;
+                    regionIndex = LatinSquare::DEFAULT_REGION_INDEX;
+                    counter = 0;
 
-                    cellIndex_ = region.firstTriangularLocalEnabledCellIndex();
+                    cellIndex = region.firstTriangularLocalEnabledCellIndex();
                     const auto& symmetricCellUpdateData =
-                        symmetricLatinSquare.triangularDisable(cellIndex_, region.index());
+                        symmetricLatinSquare.triangularDisable(cellIndex, region.index());
+
+                    symmetricUpdateHistory.emplace_back(region.index(), symmetricCellUpdateData,
+                        symmetricLatinSquare.triangularDisableAndDecrease(cellIndex, region.index()));
+                    symmetricBacktrackingHistory.emplace_back(region.index(), symmetricCellUpdateData);
+
+                    if (nodes && transversalSize == SPLIT_DEPTH) {
+                        if (node++ == claimedNode) {
+                            claimedNode = nodes->fetch_add(1, std::memory_order_relaxed);
+                        } else {
+                            --transversalSize;
+                            counter = 1;
+
+                            regionIndex = symmetricUpdateHistory.back().regionIndex();
 
-                    symmetricUpdateHistory_.emplace_back(region.index(), symmetricCellUpdateData,
-                        symmetricLatinSquare.triangularDisableAndDecrease(cellIndex_, region.index()));
-                    symmetricBacktrackingHistory_.emplace_back(region.index(), symmetricCellUpdateData);
+                            symmetricLatinSquare.triangularEnable(
+                                regionIndex, symmetricUpdateHistory.back().cellUpdateData());
+                            symmetricLatinSquare.triangularEnableAndIncrease(
+                                symmetricUpdateHistory.back().otherCellsUpdateData());
+
+                            symmetricUpdateHistory.pop_back();
+                        }
+                    }
                 } else {
-                    --transversalSize_;
+                    --transversalSize;
 
-                    if (++counter_ > 1) {
-                        regionIndex_ = symmetricBacktrackingHistory_.back().regionIndex();
+                    if (++counter > 1) {
+                        regionIndex = symmetricBacktrackingHistory.back().regionIndex();
 
                         symmetricLatinSquare.triangularEnableAndIncrease(
-                            symmetricBacktrackingHistory_.back().cellUpdateData()[0]);
+                            symmetricBacktrackingHistory.back().cellUpdateData()[0]);
 
-                        symmetricBacktrackingHistory_.pop_back();
+                        symmetricBacktrackingHistory.pop_back();
 
-                        while (symmetricBacktrackingHistory_.size()
-                               && regionIndex_ == symmetricBacktrackingHistory_.back().regionIndex()) {
+                        while (symmetricBacktrackingHistory.size()
+                               && regionIndex == symmetricBacktrackingHistory.back().regionIndex()) {
                             symmetricLatinSquare.triangularEnableAndIncrease(
-                                symmetricBacktrackingHistory_.back().cellUpdateData()[0]);
+                                symmetricBacktrackingHistory.back().cellUpdateData()[0]);
 
-                            symmetricBacktrackingHistory_.pop_back();
+                            symmetricBacktrackingHistory.pop_back();
                         }
 
-                        if (symmetricUpdateHistory_.empty()) {
+                        if (symmetricUpdateHistory.empty()) {
                             break;
                         }
                     }
 
-                    regionIndex_ = symmetricUpdateHistory_.back().regionIndex();
+                    regionIndex = symmetricUpdateHistory.back().regionIndex();
 
-                    symmetricLatinSquare.triangularEnable(
-                        regionIndex_, symmetricUpdateHistory_.back().cellUpdateData());
+                    symmetricLatinSquare.triangularEnable(regionIndex, symmetricUpdateHistory.back().cellUpdateData());
                     symmetricLatinSquare.triangularEnableAndIncrease(
-                        symmetricUpdateHistory_.back().otherCellsUpdateData());
+                        symmetricUpdateHistory.back().otherCellsUpdateData());
 
-                    symmetricUpdateHistory_.pop_back();
+                    symmetricUpdateHistory.pop_back();
                 }
             } else {
-                --transversalSize_;
-                counter_ = 1;
-                transversalsCounter_ += symmetricLatinSquare.lastNotChosenTriangularRegion().entropy();
+                --transversalSize;
+                counter = 1;
 
-                regionIndex_ = symmetricUpdateHistory_.back().regionIndex();
+                if (!nodes || main || almostSize >= SPLIT_DEPTH) {
+                    transversalsCounter += symmetricLatinSquare.lastNotChosenTriangularRegion().entropy();
+                }
 
-                symmetricLatinSquare.triangularEnable(regionIndex_, symmetricUpdateHistory_.back().cellUpdateData());
-                symmetricLatinSquare.triangularEnableAndIncrease(symmetricUpdateHistory_.back().otherCellsUpdateData());
+                regionIndex = symmetricUpdateHistory.back().regionIndex();
 
-                symmetricUpdateHistory_.pop_back();
+                symmetricLatinSquare.triangularEnable(regionIndex, symmetricUpdateHistory.back().cellUpdateData());
+                symmetricLatinSquare.triangularEnableAndIncrease(symmetricUpdateHistory.back().otherCellsUpdateData());
+
+                symmetricUpdateHistory.pop_back();
             }
         }
 
-        // std::cout << "Iterations: " << iterations_ << std::endl;
+        // std::cout << "Iterations: " << iterations << std::endl;
 
-        return transversalsCounter_;
+        return transversalsCounter;
+    }
+
+    boost::multiprecision::mpz_int Generator::parallelSymmetricTriangularCount(
+        LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) const noexcept {
+        std::vector<uint_fast8_t> numbers;
+        numbers.reserve(symmetricLatinSquare.triangularGrid().size());
+
+        for (const auto& cell : symmetricLatinSquare.triangularGrid()) {
+            numbers.emplace_back(cell->number());
+        }
+
+        std::atomic<uint_fast64_t> nodes = 0;
+        std::vector<boost::multiprecision::mpz_int> transversalsCounters(threadsCount_);
+        std::vector<std::thread> threads;
+        threads.reserve(threadsCount_);
+
+        for (uint_fast32_t index = 0; index < threadsCount_; ++index) {
+            threads.emplace_back([this, &symmetricLatinSquare, &numbers, &nodes, &transversalsCounters, index] {
+                LatinSquare::SymmetricLatinSquare threadSymmetricLatinSquare(symmetricLatinSquare.size(), numbers);
+                threadSymmetricLatinSquare.setNumberRegions();
+
+                transversalsCounters[index] = symmetricTriangularCount(threadSymmetricLatinSquare, &nodes, !index);
+            });
+        }
+
+        boost::multiprecision::mpz_int transversalsCounter = 0;
+
+        for (uint_fast32_t index = 0; index < threadsCount_; ++index) {
+            threads[index].join();
+            transversalsCounter += transversalsCounters[index];
+        }
+
+        return transversalsCounter;
     }
 
     const std::vector<SymmetricMinMaxData>& Generator::symmetricTriangularMinMax(
         const uint_fast8_t size, const LatinSquare::Type type) noexcept {
+        if (type == LatinSquare::Type::Normal) {
+            static_cast<void>(symmetricTriangularMinMax(size, LatinSquare::Type::Reduced));
+            symmetricNormalMinMax(size);
+
+            return symmetricLatinSquaresCounters_;
+        }
+
         LatinSquare::SymmetricLatinSquare symmetricLatinSquare(size, type);
 
         boost::multiprecision::mpz_int transversalsCounter;
+        symmetricLatinSquaresCounters_.clear();
         symmetricLatinSquaresCounters_.reserve(2);
 
         if (type == LatinSquare::Type::ReducedDiagonal) {
@@ -1060,7 +1893,7 @@ namespace Transversal {
         }
 
         if (!symmetricLatinSquare.notFilled()) {
-            if (symmetricLatinSquare.checkDiagonal()) {
+            if (inShard(0) && symmetricLatinSquare.checkDiagonal()) {
                 symmetricLatinSquare.fillDiagonal();
 
                 symmetricLatinSquare.setNumberRegions();
@@ -1081,12 +1914,23 @@ namespace Transversal {
         uint_fast8_t number;
         LatinSquare::EntropyData entropyData;
 
+        latinSquareUpdateHistory_.clear();
+        latinSquareBacktrackingHistory_.clear();
         latinSquareUpdateHistory_.reserve(symmetricLatinSquare.notFilled());
         latinSquareBacktrackingHistory_.reserve(symmetricLatinSquare.notFilled());
 
-        symmetricLatinSquaresCounters_.emplace_back(factorial(size), 1, symmetricLatinSquare);
+        symmetricLatinSquaresCounters_.emplace_back(LatinSquare::factorial(size), 1, symmetricLatinSquare);
         symmetricLatinSquaresCounters_.emplace_back(-1, 1, symmetricLatinSquare);
+        minMaxNodes_.fill(UINT_FAST64_MAX);
+
+        if (threadsCount_ > 1) {
+            parallelSymmetricTriangularMinMax(size, type);
+
+            return symmetricLatinSquaresCounters_;
+        }
+
         uint_fast16_t counter = 0;
+        shardNode_ = 0;
 
         while (true) {
             if (symmetricLatinSquare.notFilled()) {
@@ -1107,6 +1951,18 @@ namespace Transversal {
                         || cell.index() != latinSquareBacktrackingHistory_.back().index()) {
                         latinSquareBacktrackingHistory_.emplace_back(cell.index(), entropyData);
                     }
+
+                    if (notInShard(latinSquareUpdateHistory_.size())) {
+                        counter = 1;
+
+                        index = latinSquareUpdateHistory_.back().index();
+
+                        symmetricLatinSquare.clearAndRemove(index, latinSquareUpdateHistory_.back().entropyData());
+                        symmetricLatinSquare.restore(
+                            latinSquareUpdateHistory_.back().indexes(), latinSquareUpdateHistory_.back().number());
+
+                        latinSquareUpdateHistory_.pop_back();
+                    }
                 } else {
                     if (latinSquareUpdateHistory_.empty()) {
                         break;
@@ -1134,7 +1990,7 @@ namespace Transversal {
             } else {
                 counter = 1;
 
-                if (symmetricLatinSquare.checkDiagonal()) {
+                if (inShard(latinSquareUpdateHistory_.size()) && symmetricLatinSquare.checkDiagonal()) {
                     symmetricLatinSquare.fillDiagonal();
 
                     symmetricLatinSquare.setNumberRegions();
@@ -1144,6 +2000,7 @@ namespace Transversal {
                         symmetricLatinSquaresCounters_[0].set(transversalsCounter);
                         symmetricLatinSquaresCounters_[0].reset();
                         symmetricLatinSquaresCounters_[0].set(symmetricLatinSquare);
+                        minMaxNodes_[0] = shardNode_;
                     } else if (transversalsCounter == symmetricLatinSquaresCounters_[0].counter()) {
                         symmetricLatinSquaresCounters_[0].increase();
                     }
@@ -1152,6 +2009,7 @@ namespace Transversal {
                         symmetricLatinSquaresCounters_[1].set(transversalsCounter);
                         symmetricLatinSquaresCounters_[1].reset();
                         symmetricLatinSquaresCounters_[1].set(symmetricLatinSquare);
+                        minMaxNodes_[1] = shardNode_;
                     } else if (transversalsCounter == symmetricLatinSquaresCounters_[1].counter()) {
                         symmetricLatinSquaresCounters_[1].increase();
                     }
@@ -1181,9 +2039,61 @@ namespace Transversal {
         return symmetricLatinSquaresCounters_;
     }
 
+    void Generator::parallelSymmetricTriangularMinMax(const uint_fast8_t size, const LatinSquare::Type type) noexcept {
+        std::vector<Generator> generators(threadsCount_);
+        std::vector<std::thread> threads;
+        threads.reserve(threadsCount_);
+
+        for (uint_fast32_t index = 0; index < threadsCount_; ++index) {
+            generators[index].shard(index, threadsCount_);
+
+            threads.emplace_back([&generators, index, size, type] {
+                static_cast<void>(generators[index].symmetricTriangularMinMax(size, type));
+            });
+        }
+
+        for (uint_fast32_t index = 0; index < threadsCount_; ++index) {
+            threads[index].join();
+
+            const auto& generator = generators[index];
+
+            if (generator.minMaxNodes_[1] == UINT_FAST64_MAX) {
+                continue;
+            }
+
+            for (uint_fast8_t bound = 0; bound < 2; ++bound) {
+                auto& symmetricLatinSquaresCounter = symmetricLatinSquaresCounters_[bound];
+                const auto& otherSymmetricLatinSquaresCounter = generator.symmetricLatinSquaresCounters_[bound];
+
+                if (bound ? otherSymmetricLatinSquaresCounter.counter() > symmetricLatinSquaresCounter.counter()
+                          : otherSymmetricLatinSquaresCounter.counter() < symmetricLatinSquaresCounter.counter()) {
+                    symmetricLatinSquaresCounter = otherSymmetricLatinSquaresCounter;
+                    minMaxNodes_[bound] = generator.minMaxNodes_[bound];
+                } else if (otherSymmetricLatinSquaresCounter.counter() == symmetricLatinSquaresCounter.counter()) {
+                    if (generator.minMaxNodes_[bound] < minMaxNodes_[bound]) {
+                        const auto symmetricLatinSquaresCount =
+                            symmetricLatinSquaresCounter.symmetricLatinSquaresCounter();
+                        symmetricLatinSquaresCounter = otherSymmetricLatinSquaresCounter;
+                        symmetricLatinSquaresCounter.increase(symmetricLatinSquaresCount);
+                        minMaxNodes_[bound] = generator.minMaxNodes_[bound];
+                    } else {
+                        symmetricLatinSquaresCounter.increase(
+                            otherSymmetricLatinSquaresCounter.symmetricLatinSquaresCounter());
+                    }
+                }
+            }
+        }
+
+        if (symmetricLatinSquaresCounters_[0].counter() > symmetricLatinSquaresCounters_[1].counter()) {
+            symmetricLatinSquaresCounters_[0].set(0);
+            symmetricLatinSquaresCounters_[1].set(0);
+        }
+    }
+
     const std::vector<SymmetricMinMaxData>& Generator::symmetricTriangularMinMax(
         LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept {
         boost::multiprecision::mpz_int transversalsCounter;
+        symmetricLatinSquaresCounters_.clear();
         symmetricLatinSquaresCounters_.reserve(2);
 
         if (!symmetricLatinSquare.notFilled()) {
@@ -1208,10 +2118,13 @@ namespace Transversal {
         uint_fast8_t number;
         LatinSquare::EntropyData entropyData;
 
+        latinSquareUpdateHistory_.clear();
+        latinSquareBacktrackingHistory_.clear();
         latinSquareUpdateHistory_.reserve(symmetricLatinSquare.notFilled());
         latinSquareBacktrackingHistory_.reserve(symmetricLatinSquare.notFilled());
 
-        symmetricLatinSquaresCounters_.emplace_back(factorial(symmetricLatinSquare.size()), 1, symmetricLatinSquare);
+        symmetricLatinSquaresCounters_.emplace_back(
+            LatinSquare::factorial(symmetricLatinSquare.size()), 1, symmetricLatinSquare);
         symmetricLatinSquaresCounters_.emplace_back(-1, 1, symmetricLatinSquare);
         uint_fast16_t counter = 0;
 
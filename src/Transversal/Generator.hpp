@@ -1,10 +1,13 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include <boost/multiprecision/gmp.hpp>
+#include <cpp/random.hpp>
 
 #include "BacktrackingData.hpp"
 #include "LatinSquare/BacktrackingData.hpp"
@@ -12,6 +15,7 @@
 #include "LatinSquare/LatinSquare.hpp"
 #include "LatinSquare/SymmetricLatinSquare.hpp"
 #include "LatinSquare/UpdateData.hpp"
+#include "LatinSquare/Writer.hpp"
 #include "MinMaxData.hpp"
 #include "SymmetricBacktrackingData.hpp"
 #include "SymmetricMinMaxData.hpp"
@@ -22,8 +26,15 @@ namespace Transversal {
     class Generator {
         public:
             [[nodiscard]] const std::vector<uint_fast16_t> random(LatinSquare::LatinSquare& latinSquare) noexcept;
+            [[nodiscard]] const std::string randomBatch(
+                LatinSquare::LatinSquare& latinSquare, const uint_fast32_t count) noexcept;
 
             [[nodiscard]] const boost::multiprecision::mpz_int count(LatinSquare::LatinSquare& latinSquare) noexcept;
+            [[nodiscard]] const boost::multiprecision::mpz_int enumerate(
+                LatinSquare::LatinSquare& latinSquare, const std::string& filename) const noexcept;
+            [[nodiscard]] const std::vector<uint_fast16_t>& partial(LatinSquare::LatinSquare& latinSquare) noexcept;
+            [[nodiscard]] const std::vector<uint_fast8_t> mate(LatinSquare::LatinSquare& latinSquare) noexcept;
+            [[nodiscard]] const std::vector<uint_fast8_t> packing(LatinSquare::LatinSquare& latinSquare) noexcept;
             [[nodiscard]] const std::vector<MinMaxData>& minMax(
                 const uint_fast8_t size, const LatinSquare::Type type) noexcept;
             [[nodiscard]] const std::vector<MinMaxData>& minMax(LatinSquare::LatinSquare& latinSquare) noexcept;
@@ -38,8 +49,8 @@ namespace Transversal {
             [[nodiscard]] const std::vector<SymmetricMinMaxData>& symmetricMinMax(
                 LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept;
 
-            // [[nodiscard]] const std::vector<uint_fast16_t> symmetricTriangularRandom(
-            //     LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept;
+            [[nodiscard]] const std::vector<uint_fast16_t> symmetricTriangularRandom(
+                LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept;
 
             [[nodiscard]] const boost::multiprecision::mpz_int symmetricTriangularCount(
                 LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept;
@@ -48,8 +59,75 @@ namespace Transversal {
             [[nodiscard]] const std::vector<SymmetricMinMaxData>& symmetricTriangularMinMax(
                 LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept;
 
+            inline constexpr void shard(const uint_fast32_t index, const uint_fast32_t count) noexcept {
+                shardIndex_ = index;
+                shardsCount_ = count;
+            }
+
+            inline constexpr void threads(const uint_fast32_t count) noexcept {
+                threadsCount_ = count;
+            }
+
+            [[nodiscard]] inline constexpr bool countMaximum() const noexcept {
+                return countMaximum_;
+            }
+
+            inline constexpr void countMaximum(const bool countMaximum) noexcept {
+                countMaximum_ = countMaximum;
+            }
+
+            inline constexpr void distinct(const bool distinct) noexcept {
+                distinct_ = distinct;
+            }
+
+            [[nodiscard]] inline const boost::multiprecision::mpz_int& maxCounter() const noexcept {
+                return maxCounter_;
+            }
+
+            [[nodiscard]] inline const boost::multiprecision::mpz_int& transversalsCounter() const noexcept {
+                return transversalsCounter_;
+            }
+
+            [[nodiscard]] inline constexpr uint_fast8_t packingSize() const noexcept {
+                return packingSize_;
+            }
+
         private:
-            [[nodiscard]] constexpr boost::multiprecision::mpz_int factorial(const uint_fast8_t size) noexcept;
+            [[nodiscard]] const std::vector<uint_fast16_t> random(
+                LatinSquare::LatinSquare& latinSquare, cpp::splitmix64& splitmix64) noexcept;
+            [[nodiscard]] const boost::multiprecision::mpz_int count(
+                LatinSquare::LatinSquare& latinSquare, const uint_fast8_t selected) noexcept;
+            template <typename Descend, typename Leaf>
+            [[nodiscard]] boost::multiprecision::mpz_int search(LatinSquare::LatinSquare& latinSquare,
+                uint_fast8_t transversalSize, const uint_fast8_t almostSize, std::vector<UpdateData>& updateHistory,
+                std::vector<BacktrackingData>& backtrackingHistory, Descend&& descend, Leaf&& leaf) const noexcept;
+            [[nodiscard]] const boost::multiprecision::mpz_int incrementalCount(
+                LatinSquare::LatinSquare& latinSquare, const uint_fast16_t lastIndex) noexcept;
+            void symmetricNormalMinMax(const uint_fast8_t size) noexcept;
+            void partial(LatinSquare::LatinSquare& latinSquare, const uint_fast8_t depth) noexcept;
+            [[nodiscard]] bool mate(const uint_fast8_t size, const uint_fast8_t depth) noexcept;
+            void packing(const uint_fast8_t depth) noexcept;
+
+            [[nodiscard]] inline constexpr bool inShard(const size_t depth) const noexcept {
+                return depth >= LatinSquare::SHARD_DEPTH || !shardIndex_;
+            }
+
+            [[nodiscard]] inline constexpr bool notInShard(const size_t depth) noexcept {
+                return depth == LatinSquare::SHARD_DEPTH && shardNode_++ % shardsCount_ != shardIndex_;
+            }
+
+            [[nodiscard]] boost::multiprecision::mpz_int enumerate(LatinSquare::LatinSquare& latinSquare,
+                std::string& transversals, LatinSquare::Writer* writer, std::atomic<uint_fast64_t>* nodes,
+                const bool main) const noexcept;
+            [[nodiscard]] boost::multiprecision::mpz_int parallelEnumerate(
+                LatinSquare::LatinSquare& latinSquare, const std::string& filename) const noexcept;
+
+            [[nodiscard]] boost::multiprecision::mpz_int symmetricTriangularCount(
+                LatinSquare::SymmetricLatinSquare& symmetricLatinSquare, std::atomic<uint_fast64_t>* nodes,
+                const bool main) const noexcept;
+            [[nodiscard]] boost::multiprecision::mpz_int parallelSymmetricTriangularCount(
+                LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) const noexcept;
+            void parallelSymmetricTriangularMinMax(const uint_fast8_t size, const LatinSquare::Type type) noexcept;
 
             uint_fast8_t transversalSize_;
             uint_fast8_t almostSize_;
@@ -65,6 +143,44 @@ namespace Transversal {
             std::vector<LatinSquare::BacktrackingData> latinSquareBacktrackingHistory_;
             std::vector<MinMaxData> latinSquaresCounters_;
             std::vector<SymmetricMinMaxData> symmetricLatinSquaresCounters_;
+            uint_fast32_t shardIndex_ = 0;
+            uint_fast32_t shardsCount_ = 1;
+            uint_fast64_t shardNode_;
+            uint_fast32_t threadsCount_ = 1;
+            std::array<uint_fast64_t, 2> minMaxNodes_;
+            std::vector<uint_fast16_t> frontierIndexes_;
+            std::vector<uint_fast8_t> frontierNumbers_;
+            uint_fast16_t frontierDepth_;
+            std::vector<boost::multiprecision::mpz_int> frontierCounters_;
+            std::vector<uint_fast16_t> frontierCells_;
+            std::vector<boost::multiprecision::mpz_int> frontierSums_;
+            std::vector<uint_fast16_t> frontierConflicts_;
+            std::vector<std::vector<uint_fast16_t>> candidates_;
+            std::vector<std::vector<uint_fast16_t>> disabledIndexes_;
+            std::vector<uint_fast16_t> partialTransversal_;
+            std::vector<uint_fast16_t> maxTransversal_;
+            uint_fast8_t maxLength_;
+            boost::multiprecision::mpz_int maxCounter_;
+            bool countMaximum_ = false;
+            bool distinct_ = false;
+            std::string transversals_;
+            std::vector<uint_fast64_t> transversalMasks_;
+            uint_fast16_t maskWords_;
+            std::vector<uint_fast64_t> coveredMask_;
+            std::vector<std::vector<uint_fast32_t>> mateCandidates_;
+            std::vector<uint_fast32_t> cellCounters_;
+            std::vector<uint_fast32_t> mateTransversals_;
+            uint_fast32_t packingWords_;
+            uint_fast8_t packingSize_;
+            uint_fast8_t maxPackingSize_;
+            std::vector<uint_fast32_t> packingOrder_;
+            std::vector<uint_fast64_t> packingNeighbours_;
+            std::vector<std::vector<uint_fast64_t>> packingCandidates_;
+            std::vector<uint_fast64_t> packingUncolored_;
+            std::vector<uint_fast64_t> packingColorClass_;
+            std::vector<std::vector<uint_fast32_t>> packingVertices_;
+            std::vector<std::vector<uint_fast8_t>> packingColors_;
+            std::vector<uint_fast32_t> packingClique_;
             // boost::multiprecision::mpz_int iterations_;
     };
 }
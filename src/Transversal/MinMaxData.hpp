@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include <boost/multiprecision/gmp.hpp>
 
 #include "LatinSquare/LatinSquare.hpp"
@@ -10,7 +14,18 @@ namespace Transversal {
             inline explicit MinMaxData(const boost::multiprecision::mpz_int& counter,
                 const boost::multiprecision::mpz_int& latinSquaresCounter,
                 const LatinSquare::LatinSquare& latinSquare) noexcept
-                : counter_(counter), latinSquaresCounter_(latinSquaresCounter), latinSquare_(latinSquare) {}
+                : counter_(counter), latinSquaresCounter_(latinSquaresCounter), size_(latinSquare.size()) {
+                numbers_.reserve(latinSquare.grid().size());
+
+                for (const auto& cell : latinSquare.grid()) {
+                    numbers_.emplace_back(cell->number());
+                }
+            }
+
+            inline explicit MinMaxData(const boost::multiprecision::mpz_int& counter,
+                const boost::multiprecision::mpz_int& latinSquaresCounter, const uint_fast8_t size,
+                const std::vector<uint_fast8_t>& numbers) noexcept
+                : counter_(counter), latinSquaresCounter_(latinSquaresCounter), size_(size), numbers_(numbers) {}
 
             MinMaxData(const MinMaxData&) = default;
             MinMaxData& operator=(const MinMaxData&) = default;
@@ -26,8 +41,8 @@ namespace Transversal {
                 return latinSquaresCounter_;
             }
 
-            [[nodiscard]] inline const LatinSquare::LatinSquare& latinSquare() const noexcept {
-                return latinSquare_;
+            [[nodiscard]] inline const LatinSquare::LatinSquare latinSquare() const noexcept {
+                return LatinSquare::LatinSquare(size_, numbers_);
             }
 
             inline constexpr void set(const boost::multiprecision::mpz_int& counter) noexcept {
@@ -43,12 +58,17 @@ namespace Transversal {
             }
 
             inline constexpr void set(const LatinSquare::LatinSquare& latinSquare) noexcept {
-                latinSquare_ = latinSquare;
+                const auto& grid = latinSquare.grid();
+
+                for (size_t index = 0; index < numbers_.size(); ++index) {
+                    numbers_[index] = grid[index]->number();
+                }
             }
 
         private:
             boost::multiprecision::mpz_int counter_;
             boost::multiprecision::mpz_int latinSquaresCounter_;
-            LatinSquare::LatinSquare latinSquare_;
+            uint_fast8_t size_;
+            std::vector<uint_fast8_t> numbers_;
     };
 }
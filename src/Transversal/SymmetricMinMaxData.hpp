@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include <boost/multiprecision/gmp.hpp>
 
 #include "LatinSquare/SymmetricLatinSquare.hpp"
@@ -11,7 +15,13 @@ namespace Transversal {
                 const boost::multiprecision::mpz_int& symmetricLatinSquaresCounter,
                 const LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept
                 : counter_(counter), symmetricLatinSquaresCounter_(symmetricLatinSquaresCounter),
-                  symmetricLatinSquare_(symmetricLatinSquare) {}
+                  size_(symmetricLatinSquare.size()) {
+                numbers_.reserve(symmetricLatinSquare.triangularGrid().size());
+
+                for (const auto& cell : symmetricLatinSquare.triangularGrid()) {
+                    numbers_.emplace_back(cell->number());
+                }
+            }
 
             SymmetricMinMaxData(const SymmetricMinMaxData&) = default;
             SymmetricMinMaxData& operator=(const SymmetricMinMaxData&) = default;
@@ -27,8 +37,14 @@ namespace Transversal {
                 return symmetricLatinSquaresCounter_;
             }
 
-            [[nodiscard]] inline const LatinSquare::SymmetricLatinSquare& symmetricLatinSquare() const noexcept {
-                return symmetricLatinSquare_;
+            [[nodiscard]] inline const LatinSquare::SymmetricLatinSquare symmetricLatinSquare() const noexcept {
+                LatinSquare::SymmetricLatinSquare symmetricLatinSquare(size_, numbers_);
+
+                if (!symmetricLatinSquare.notFilled()) {
+                    symmetricLatinSquare.fillGrid();
+                }
+
+                return symmetricLatinSquare;
             }
 
             inline constexpr void set(const boost::multiprecision::mpz_int& counter) noexcept {
@@ -43,13 +59,26 @@ namespace Transversal {
                 ++symmetricLatinSquaresCounter_;
             }
 
+            inline constexpr void increase(const boost::multiprecision::mpz_int& symmetricLatinSquaresCounter) noexcept {
+                symmetricLatinSquaresCounter_ += symmetricLatinSquaresCounter;
+            }
+
+            inline constexpr void multiply(const boost::multiprecision::mpz_int& factor) noexcept {
+                symmetricLatinSquaresCounter_ *= factor;
+            }
+
             inline constexpr void set(const LatinSquare::SymmetricLatinSquare& symmetricLatinSquare) noexcept {
-                symmetricLatinSquare_ = symmetricLatinSquare;
+                const auto& triangularGrid = symmetricLatinSquare.triangularGrid();
+
+                for (size_t index = 0; index < numbers_.size(); ++index) {
+                    numbers_[index] = triangularGrid[index]->number();
+                }
             }
 
         private:
             boost::multiprecision::mpz_int counter_;
             boost::multiprecision::mpz_int symmetricLatinSquaresCounter_;
-            LatinSquare::SymmetricLatinSquare symmetricLatinSquare_;
+            uint_fast8_t size_;
+            std::vector<uint_fast8_t> numbers_;
     };
 }
@@ -1,144 +1,160 @@
 #include "Utils.hpp"
 
 #include <algorithm>
-#include <cmath>
+#include <array>
 #include <cstddef>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
-#include <cpp/iostream.hpp>
 #include <cpp/string.hpp>
 
+#include "Constants.hpp"
+#include "LatinSquare/Constants.hpp"
+#include "LatinSquare/Formatter.hpp"
+
 namespace Transversal {
-    void printBoard(LatinSquare::LatinSquare& latinSquare, std::vector<uint_fast16_t>& transversal) noexcept {
-        if (transversal.empty()) {
-            const std::string info = "Transversal was not found";
-            std::cout.write(info.c_str(), info.size());
-            std::cout.put('\n');
-        } else {
-            const auto& grid = latinSquare.grid();
-            std::sort(transversal.begin(), transversal.end());
-            const auto barLength = static_cast<uint_fast8_t>(std::log10(latinSquare.size()) + 1) + 2;
-            std::string shortBar = std::string(barLength, '-'), longBar = "+", leftBar = "+", rightBar = shortBar,
-                repeatedLeftBar, spaces, numberString;
-            longBar.append(shortBar);
-            longBar.append("+");
-            leftBar.append(shortBar);
-            rightBar.append("+");
-            auto isTransversalCell = false, isTransversalPreviousCell = false;
-            uint_fast8_t index = 0, column = 0, previousColumn = 0, difference = 0, number = 0;
-
-            for (const auto& cell : grid) {
-                isTransversalCell = (transversal[index] == cell->index());
-
-                if (cell->rawColumn() == 0) {
-                    column = grid[transversal[index]]->rawColumn();
-
-                    if (cell->rawRow() == 0) {
-                        repeatedLeftBar = cpp::repeat(leftBar, column);
-                        std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                        std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-                        std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-                        std::cout.write(longBar.c_str(), longBar.size());
-                        std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-
-                        if (column != latinSquare.size() - 1) {
-                            repeatedLeftBar = cpp::repeat(leftBar, latinSquare.size() - column - 2);
-                            std::cout.write(shortBar.c_str(), shortBar.size());
-                            std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                            std::cout.put('+');
-                        }
-
-                        std::cout.put('\n');
-                    } else {
-                        const auto [firstColumn, secondColumn] = std::minmax(previousColumn, column);
-                        difference = secondColumn - firstColumn - 1;
-                        repeatedLeftBar = cpp::repeat(leftBar, firstColumn);
-                        std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                        std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-                        std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-                        std::cout.write(longBar.c_str(), longBar.size());
-                        std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-
-                        if (difference == 0) {
-                            std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-                            std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-                            std::cout.write(rightBar.c_str(), rightBar.size());
-                            std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-                        } else {
-                            repeatedLeftBar = cpp::repeat(leftBar, difference - 1);
-                            std::cout.write(shortBar.c_str(), shortBar.size());
-                            std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                            std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-                            std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-                            std::cout.write(longBar.c_str(), longBar.size());
-                            std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-                        }
-
-                        if (secondColumn != latinSquare.size() - 1) {
-                            repeatedLeftBar = cpp::repeat(leftBar, latinSquare.size() - secondColumn - 2);
-                            std::cout.write(shortBar.c_str(), shortBar.size());
-                            std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                            std::cout.put('+');
-                        }
-
-                        std::cout.put('\n');
+    bool noTransversals(const LatinSquare::LatinSquare& latinSquare) noexcept {
+        return parityCertificate(latinSquare) || cyclicSylowGroup(latinSquare);
+    }
+
+    // A square is isotopic to a group exactly when its loop isotope built from the first row and column is
+    // associative. By the Hall-Paige theorem a group table has a transversal unless its Sylow 2-subgroup is cyclic and
+    // not trivial, which is the case when some element has the full power of 2 dividing the order in its order.
+    bool cyclicSylowGroup(const LatinSquare::LatinSquare& latinSquare) noexcept {
+        const auto size = latinSquare.size();
+        const auto& grid = latinSquare.grid();
+
+        if (size & 1) {
+            return false;
+        }
+
+        std::vector<uint_fast8_t> rows(size), columns(size), table(size * size);
+
+        for (uint_fast8_t index = 0; index < size; ++index) {
+            rows[grid[index * size]->number()] = index;
+            columns[grid[index]->number()] = index;
+        }
+
+        for (uint_fast8_t x = 0; x < size; ++x) {
+            for (uint_fast8_t y = 0; y < size; ++y) {
+                table[x * size + y] = grid[rows[x] * size + columns[y]]->number();
+            }
+        }
+
+        for (uint_fast8_t x = 0; x < size; ++x) {
+            for (uint_fast8_t y = 0; y < size; ++y) {
+                const auto xy = table[x * size + y];
+
+                for (uint_fast8_t z = 0; z < size; ++z) {
+                    if (table[xy * size + z] != table[x * size + table[y * size + z]]) {
+                        return false;
                     }
                 }
+            }
+        }
 
-                number = cell->number();
-                spaces = std::string(static_cast<uint_fast8_t>(std::log10(latinSquare.size()))
-                                     - static_cast<uint_fast8_t>(std::log10(++number)) + 1, ' ');
-                numberString = std::to_string(number);
-
-                if (isTransversalCell) {
-                    std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-                    std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-                    std::cout.put('|');
-                    std::cout.write(spaces.c_str(), spaces.size());
-                    std::cout.write(numberString.c_str(), numberString.size());
-                    std::cout.put(' ');
-                    std::cout.put('|');
-                    std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-                } else {
-                    if (!isTransversalPreviousCell) {
-                        std::cout.put('|');
-                    }
+        const auto identity = grid[0]->number();
+        const uint_fast8_t sylowSize = size & (~size + 1);
+
+        for (uint_fast8_t x = 0; x < size; ++x) {
+            uint_fast8_t order = 1;
+
+            for (auto power = x; power != identity; power = table[power * size + x]) {
+                ++order;
+            }
 
-                    std::cout.write(spaces.c_str(), spaces.size());
-                    std::cout.write(numberString.c_str(), numberString.size());
-                    std::cout.put(' ');
+            if (order % sylowSize == 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Numbers a(row) + b(column) + c(number) = 0 (mod 2) for every cell add up over a transversal to the sum of all
+    // of them. If some solution has an odd sum, no transversal exists. Such a solution exists exactly when the all-ones
+    // vector is not a combination of the equations of the cells.
+    bool parityCertificate(const LatinSquare::LatinSquare& latinSquare) noexcept {
+        using Equation = std::array<uint_fast64_t, 3>;
+
+        const auto size = latinSquare.size();
+        const uint_fast16_t variables = 3 * size;
+        std::vector<Equation> basis(variables, Equation{0, 0, 0});
+        std::vector<bool> pivots(variables, false);
+
+        const auto reduce = [&basis, &pivots, variables](Equation& equation) {
+            for (uint_fast16_t variable = 0; variable < variables; ++variable) {
+                if (!(equation[variable >> 6] & (1ULL << (variable & 63)))) {
+                    continue;
                 }
 
-                if (cell->rawColumn() == latinSquare.size() - 1) {
-                    if (!isTransversalCell) {
-                        std::cout.put('|');
-                    }
+                if (!pivots[variable]) {
+                    return variable;
+                }
 
-                    std::cout.put('\n');
-                    isTransversalPreviousCell = false;
-                    previousColumn = column;
-                    ++index;
-                } else {
-                    isTransversalPreviousCell = isTransversalCell;
+                for (uint_fast8_t word = 0; word < 3; ++word) {
+                    equation[word] ^= basis[variable][word];
                 }
             }
 
-            repeatedLeftBar = cpp::repeat(leftBar, column);
-            std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-            std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-            std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-            std::cout.write(longBar.c_str(), longBar.size());
-            std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-
-            if (column != latinSquare.size() - 1) {
-                repeatedLeftBar = cpp::repeat(leftBar, latinSquare.size() - column - 2);
-                std::cout.write(shortBar.c_str(), shortBar.size());
-                std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                std::cout.put('+');
+            return variables;
+        };
+
+        for (const auto& cell : latinSquare.grid()) {
+            Equation equation = {0, 0, 0};
+
+            for (const uint_fast16_t variable :
+                {uint_fast16_t(cell->rawRow()), uint_fast16_t(size + cell->rawColumn()),
+                    uint_fast16_t(2 * size + cell->number())}) {
+                equation[variable >> 6] |= 1ULL << (variable & 63);
+            }
+
+            if (const auto pivot = reduce(equation); pivot < variables) {
+                basis[pivot] = equation;
+                pivots[pivot] = true;
             }
+        }
+
+        Equation ones = {0, 0, 0};
 
+        for (uint_fast16_t variable = 0; variable < variables; ++variable) {
+            ones[variable >> 6] |= 1ULL << (variable & 63);
+        }
+
+        return reduce(ones) < variables;
+    }
+
+    void printBoard(LatinSquare::LatinSquare& latinSquare, std::vector<uint_fast16_t>& transversal) noexcept {
+        if (transversal.empty()) {
+            const std::string info = "Transversal was not found";
+            std::cout.write(info.c_str(), info.size());
             std::cout.put('\n');
+        } else {
+            std::sort(transversal.begin(), transversal.end());
+            LatinSquare::Formatter formatter(latinSquare.size());
+            formatter.board(latinSquare.grid(), transversal);
+            formatter.write(std::cout);
+        }
+    }
+
+    void printPartialBoard(LatinSquare::LatinSquare& latinSquare, std::vector<uint_fast16_t>& transversal) noexcept {
+        std::sort(transversal.begin(), transversal.end());
+        LatinSquare::Formatter formatter(latinSquare.size());
+        formatter.partialBoard(latinSquare.grid(), transversal);
+        formatter.write(std::cout);
+    }
+
+    void printColumns(const uint_fast8_t size, const std::string& transversals) noexcept {
+        std::string buffer;
+
+        for (size_t index = 0; index < transversals.size(); ++index) {
+            buffer.append(std::to_string(static_cast<uint_fast8_t>(transversals[index]) + 1));
+            buffer.push_back((index + 1) % size ? ' ' : '\n');
         }
+
+        std::cout.write(buffer.c_str(), buffer.size());
     }
 
     void printBoard(
@@ -149,140 +165,129 @@ namespace Transversal {
             std::cout.put('\n');
         } else {
             symmetricLatinSquare.fillGrid();
-            const auto& grid = symmetricLatinSquare.grid();
             std::sort(transversal.begin(), transversal.end());
-            const auto barLength = static_cast<uint_fast8_t>(std::log10(symmetricLatinSquare.size()) + 1) + 2;
-            std::string shortBar = std::string(barLength, '-'), longBar = "+", leftBar = "+", rightBar = shortBar,
-                repeatedLeftBar, spaces, numberString;
-            longBar.append(shortBar);
-            longBar.append("+");
-            leftBar.append(shortBar);
-            rightBar.append("+");
-            auto isTransversalCell = false, isTransversalPreviousCell = false;
-            uint_fast8_t index = 0, column = 0, previousColumn = 0, difference = 0, number = 0;
-
-            for (const auto& cell : grid) {
-                isTransversalCell = (transversal[index] == cell->index());
-
-                if (cell->rawColumn() == 0) {
-                    column = grid[transversal[index]]->rawColumn();
-
-                    if (cell->rawRow() == 0) {
-                        repeatedLeftBar = cpp::repeat(leftBar, column);
-                        std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                        std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-                        std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-                        std::cout.write(longBar.c_str(), longBar.size());
-                        std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-
-                        if (column != symmetricLatinSquare.size() - 1) {
-                            repeatedLeftBar = cpp::repeat(leftBar, symmetricLatinSquare.size() - column - 2);
-                            std::cout.write(shortBar.c_str(), shortBar.size());
-                            std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                            std::cout.put('+');
-                        }
-
-                        std::cout.put('\n');
-                    } else {
-                        const auto [firstColumn, secondColumn] = std::minmax(previousColumn, column);
-                        difference = secondColumn - firstColumn - 1;
-                        repeatedLeftBar = cpp::repeat(leftBar, firstColumn);
-                        std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                        std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-                        std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-                        std::cout.write(longBar.c_str(), longBar.size());
-                        std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-
-                        if (difference == 0) {
-                            std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-                            std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-                            std::cout.write(rightBar.c_str(), rightBar.size());
-                            std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-                        } else {
-                            repeatedLeftBar = cpp::repeat(leftBar, difference - 1);
-                            std::cout.write(shortBar.c_str(), shortBar.size());
-                            std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                            std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-                            std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-                            std::cout.write(longBar.c_str(), longBar.size());
-                            std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-                        }
-
-                        if (secondColumn != symmetricLatinSquare.size() - 1) {
-                            repeatedLeftBar = cpp::repeat(leftBar, symmetricLatinSquare.size() - secondColumn - 2);
-                            std::cout.write(shortBar.c_str(), shortBar.size());
-                            std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                            std::cout.put('+');
-                        }
-
-                        std::cout.put('\n');
+            LatinSquare::Formatter formatter(symmetricLatinSquare.size());
+            formatter.board(symmetricLatinSquare.grid(), transversal);
+            formatter.write(std::cout);
+        }
+    }
+
+    void printTriangularBoard(
+        LatinSquare::SymmetricLatinSquare& symmetricLatinSquare, std::vector<uint_fast16_t>& transversal) noexcept {
+        if (transversal.empty()) {
+            const std::string info = "Transversal was not found";
+            std::cout.write(info.c_str(), info.size());
+            std::cout.put('\n');
+        } else {
+            std::sort(transversal.begin(), transversal.end());
+            LatinSquare::Formatter formatter(symmetricLatinSquare.size());
+            formatter.triangularBoard(symmetricLatinSquare.triangularGrid(), transversal);
+            formatter.write(std::cout);
+        }
+    }
+
+    const std::tuple<size_t, std::vector<MinMaxData>, double> merge(
+        const std::vector<std::string>& filenames) noexcept {
+        std::array<boost::multiprecision::mpz_int, 2> counters, latinSquaresCounters, fileCounters,
+            fileLatinSquaresCounters;
+        std::array<std::vector<uint_fast8_t>, 2> numbers, fileNumbers;
+        std::array<uint_fast8_t, 2> sizes = {0, 0}, fileSizes;
+        std::array<bool, 2> found = {false, false};
+        double seconds = 0;
+        size_t shards = 0;
+        uint_fast8_t section, counter;
+        std::string line, word;
+
+        for (const auto& filename : filenames) {
+            std::ifstream file(filename);
+
+            if (!file) {
+                return {};
+            }
+
+            fileCounters = {0, 0};
+            fileLatinSquaresCounters = {0, 0};
+            fileNumbers[0].clear();
+            fileNumbers[1].clear();
+            fileSizes = {0, 0};
+            section = 2;
+
+            while (std::getline(file, line)) {
+                if (line.starts_with(MIN_TRANSVERSALS) || line.starts_with(MAX_TRANSVERSALS)) {
+                    section = line.starts_with(MIN_TRANSVERSALS) ? 0 : 1;
+                    word = line.substr(section ? MAX_TRANSVERSALS.size() : MIN_TRANSVERSALS.size());
+
+                    if (!cpp::is_number(word)) {
+                        return {};
                     }
-                }
 
-                number = cell->number();
-                spaces = std::string(static_cast<uint_fast8_t>(std::log10(symmetricLatinSquare.size()))
-                                     - static_cast<uint_fast8_t>(std::log10(++number)) + 1, ' ');
-                numberString = std::to_string(number);
-
-                if (isTransversalCell) {
-                    std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-                    std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-                    std::cout.put('|');
-                    std::cout.write(spaces.c_str(), spaces.size());
-                    std::cout.write(numberString.c_str(), numberString.size());
-                    std::cout.put(' ');
-                    std::cout.put('|');
-                    std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-                } else {
-                    if (!isTransversalPreviousCell) {
-                        std::cout.put('|');
+                    fileCounters[section] = boost::multiprecision::mpz_int(word);
+                } else if (line.starts_with(LATIN_SQUARES_MIN_TRANSVERSALS)
+                           || line.starts_with(LATIN_SQUARES_MAX_TRANSVERSALS)) {
+                    word = line.substr(section ? LATIN_SQUARES_MAX_TRANSVERSALS.size()
+                                               : LATIN_SQUARES_MIN_TRANSVERSALS.size());
+
+                    if (section > 1 || !cpp::is_number(word)) {
+                        return {};
                     }
 
-                    std::cout.write(spaces.c_str(), spaces.size());
-                    std::cout.write(numberString.c_str(), numberString.size());
-                    std::cout.put(' ');
-                }
+                    fileLatinSquaresCounters[section] = boost::multiprecision::mpz_int(word);
+                } else if (line.starts_with('|') && section < 2) {
+                    std::replace(line.begin(), line.end(), '|', ' ');
+                    std::istringstream iss(line);
+                    counter = 0;
 
-                if (cell->rawColumn() == symmetricLatinSquare.size() - 1) {
-                    if (!isTransversalCell) {
-                        std::cout.put('|');
+                    while (iss >> word) {
+                        fileNumbers[section].emplace_back(std::strtoul(word.c_str(), nullptr, 10) - 1);
+                        ++counter;
                     }
 
-                    std::cout.put('\n');
-                    isTransversalPreviousCell = false;
-                    previousColumn = column;
-                    ++index;
-                } else {
-                    isTransversalPreviousCell = isTransversalCell;
+                    if (!fileSizes[section]) {
+                        fileSizes[section] = counter;
+                    }
+                } else if (line.starts_with(TIME)) {
+                    seconds += std::strtod(line.c_str() + TIME.size(), nullptr);
                 }
             }
 
-            repeatedLeftBar = cpp::repeat(leftBar, column);
-            std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-            std::cout.write(cpp::bold_on().c_str(), cpp::bold_on().size());
-            std::cout.write(cpp::green_on().c_str(), cpp::green_on().size());
-            std::cout.write(longBar.c_str(), longBar.size());
-            std::cout.write(cpp::reset().c_str(), cpp::reset().size());
-
-            if (column != symmetricLatinSquare.size() - 1) {
-                repeatedLeftBar = cpp::repeat(leftBar, symmetricLatinSquare.size() - column - 2);
-                std::cout.write(shortBar.c_str(), shortBar.size());
-                std::cout.write(repeatedLeftBar.c_str(), repeatedLeftBar.size());
-                std::cout.put('+');
+            if (section != 1) {
+                continue;
             }
 
-            std::cout.put('\n');
+            ++shards;
+
+            for (section = 0; section < 2; ++section) {
+                if (fileLatinSquaresCounters[section] == 0 || !fileSizes[section]
+                    || fileNumbers[section].size() != fileSizes[section] * fileSizes[section]
+                    || std::any_of(fileNumbers[section].begin(), fileNumbers[section].end(),
+                        [&](const uint_fast8_t number) { return number >= fileSizes[section]; })) {
+                    continue;
+                }
+
+                if (!found[section] || (section ? fileCounters[section] > counters[section]
+                                                : fileCounters[section] < counters[section])) {
+                    found[section] = true;
+                    counters[section] = fileCounters[section];
+                    latinSquaresCounters[section] = fileLatinSquaresCounters[section];
+                    numbers[section] = fileNumbers[section];
+                    sizes[section] = fileSizes[section];
+                } else if (fileCounters[section] == counters[section]) {
+                    latinSquaresCounters[section] += fileLatinSquaresCounters[section];
+                }
+            }
         }
-    }
 
-    // void printTriangularBoard(
-    //     LatinSquare::SymmetricLatinSquare& symmetricLatinSquare, std::vector<uint_fast16_t>& transversal) noexcept {
-    //     if (transversal.empty()) {
-    //         const std::string info = "Transversal was not found";
-    //         std::cout.write(info.c_str(), info.size());
-    //         std::cout.put('\n');
-    //     } else {
+        std::vector<MinMaxData> counts;
+        counts.reserve(2);
 
-    //     }
-    // }
+        for (section = 0; section < 2; ++section) {
+            if (found[section]) {
+                counts.emplace_back(counters[section], latinSquaresCounters[section], sizes[section], numbers[section]);
+            } else {
+                counts.emplace_back(0, 0, 1, std::vector<uint_fast8_t>(1, LatinSquare::EMPTY));
+            }
+        }
+
+        return {shards, counts, seconds};
+    }
 }
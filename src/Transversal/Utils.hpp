@@ -1,16 +1,29 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include "LatinSquare/LatinSquare.hpp"
 #include "LatinSquare/SymmetricLatinSquare.hpp"
+#include "MinMaxData.hpp"
 
 namespace Transversal {
+    [[nodiscard]] bool noTransversals(const LatinSquare::LatinSquare& latinSquare) noexcept;
+    [[nodiscard]] bool cyclicSylowGroup(const LatinSquare::LatinSquare& latinSquare) noexcept;
+    [[nodiscard]] bool parityCertificate(const LatinSquare::LatinSquare& latinSquare) noexcept;
+
     void printBoard(LatinSquare::LatinSquare& latinSquare, std::vector<uint_fast16_t>& transversal) noexcept;
+    void printPartialBoard(LatinSquare::LatinSquare& latinSquare, std::vector<uint_fast16_t>& transversal) noexcept;
+    void printColumns(const uint_fast8_t size, const std::string& transversals) noexcept;
 
     void printBoard(
         LatinSquare::SymmetricLatinSquare& symmetricLatinSquare, std::vector<uint_fast16_t>& transversal) noexcept;
-    // void printTriangularBoard(
-    //     LatinSquare::SymmetricLatinSquare& symmetricLatinSquare, std::vector<uint_fast16_t>& transversal) noexcept;
+    void printTriangularBoard(
+        LatinSquare::SymmetricLatinSquare& symmetricLatinSquare, std::vector<uint_fast16_t>& transversal) noexcept;
+
+    [[nodiscard]] const std::tuple<size_t, std::vector<MinMaxData>, double> merge(
+        const std::vector<std::string>& filenames) noexcept;
 }
@@ -1,5 +1,8 @@
 #include <string.hpp>
 
+#include <algorithm>
+#include <cctype>
+
 namespace cpp {
     const std::string repeat(const std::string& string, uint_fast8_t repeats) {
         std::string result;
@@ -11,4 +14,10 @@ namespace cpp {
 
         return result;
     }
+
+    bool is_number(const std::string& string) {
+        return !string.empty() && std::all_of(string.begin(), string.end(), [](const unsigned char character) {
+            return std::isdigit(character);
+        });
+    }
 }
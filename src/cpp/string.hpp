@@ -5,4 +5,5 @@
 
 namespace cpp {
     const std::string repeat(const std::string& string, uint_fast8_t repeats);
+    bool is_number(const std::string& string);
 }